@@ -0,0 +1,989 @@
+/*********************                                                        */
+/*! \file bv_known_bits.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The BvKnownBits preprocessing pass
+ **
+ ** Computes the known bits and the unsigned range of bit-vector terms from
+ ** the top-level assertions by propagation to a fixpoint, and simplifies the
+ ** remaining assertions with them. Can be enabled via option
+ ** `--bv-known-bits`.
+ **/
+
+#include "preprocessing/passes/bv_known_bits.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/rewriter.h"
+#include "util/bitvector.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+using NodeMap = std::unordered_map<Node, Node, NodeHashFunction>;
+using namespace CVC4::theory;
+
+namespace {
+
+/** The maximum number of rounds of forward and backward propagation. */
+constexpr unsigned s_maxRounds = 16;
+
+/**
+ * The known bits and the unsigned range [d_lo, d_hi] of a bit-vector term.
+ * Bits of d_value that are not known are zero.
+ */
+struct Abstraction
+{
+  explicit Abstraction(unsigned size)
+      : d_known(BitVector::mkZero(size)),
+        d_value(BitVector::mkZero(size)),
+        d_lo(BitVector::mkZero(size)),
+        d_hi(BitVector::mkOnes(size))
+  {
+  }
+
+  explicit Abstraction(const BitVector& value)
+      : d_known(BitVector::mkOnes(value.getSize())),
+        d_value(value),
+        d_lo(value),
+        d_hi(value)
+  {
+  }
+
+  bool isConst() const
+  {
+    return d_known == BitVector::mkOnes(d_known.getSize());
+  }
+
+  bool operator==(const Abstraction& other) const
+  {
+    return d_known == other.d_known && d_value == other.d_value
+           && d_lo == other.d_lo && d_hi == other.d_hi;
+  }
+
+  BitVector d_known;
+  BitVector d_value;
+  BitVector d_lo;
+  BitVector d_hi;
+};
+
+using AbstractionMap = std::unordered_map<Node, Abstraction, NodeHashFunction>;
+
+/**
+ * Add the bits of `value` at the positions in `known` to the known bits of
+ * `a`. Returns false if they contradict the bits already known.
+ */
+bool addBits(Abstraction& a, const BitVector& known, const BitVector& value)
+{
+  BitVector both = a.d_known & known;
+  if ((both & (a.d_value ^ value)) != BitVector::mkZero(both.getSize()))
+  {
+    return false;
+  }
+  a.d_known = a.d_known | known;
+  a.d_value = a.d_value | (value & known);
+  return true;
+}
+
+/**
+ * Intersect the range of `a` with [lo, hi]. Returns false if the result is
+ * empty.
+ */
+bool addRange(Abstraction& a, const BitVector& lo, const BitVector& hi)
+{
+  if (a.d_lo.unsignedLessThan(lo))
+  {
+    a.d_lo = lo;
+  }
+  if (hi.unsignedLessThan(a.d_hi))
+  {
+    a.d_hi = hi;
+  }
+  return a.d_lo.unsignedLessThanEq(a.d_hi);
+}
+
+/**
+ * Tighten the known bits and the range of `a` with each other: the range is
+ * bounded by the values with all unknown bits zero resp. one, and the common
+ * most significant bits of the bounds are known. Returns false on conflict.
+ */
+bool normalize(Abstraction& a)
+{
+  if (!addRange(a, a.d_value, a.d_value | ~a.d_known))
+  {
+    return false;
+  }
+  unsigned size = a.d_known.getSize();
+  BitVector known = BitVector::mkZero(size);
+  for (unsigned i = size; i-- > 0;)
+  {
+    if (a.d_lo.isBitSet(i) != a.d_hi.isBitSet(i))
+    {
+      break;
+    }
+    known = known.setBit(i, true);
+  }
+  return addBits(a, known, a.d_lo);
+}
+
+/**
+ * Refine the abstraction of `node` with `a`. Sets `changed` if the
+ * abstraction changed, and returns false on conflict.
+ */
+bool refine(AbstractionMap& abs, TNode node, const Abstraction& a, bool& changed)
+{
+  Abstraction& cur = abs.at(node);
+  Abstraction old = cur;
+  if (!addBits(cur, a.d_known, a.d_value) || !addRange(cur, a.d_lo, a.d_hi)
+      || !normalize(cur))
+  {
+    return false;
+  }
+  changed = changed || !(cur == old);
+  return true;
+}
+
+/** The bits of `bits` at position `low` of a bit-vector of width `size`. */
+BitVector placeBits(const BitVector& bits, unsigned low, unsigned size)
+{
+  BitVector res = bits;
+  if (low > 0)
+  {
+    res = res.concat(BitVector::mkZero(low));
+  }
+  if (res.getSize() < size)
+  {
+    res = res.zeroExtend(size - res.getSize());
+  }
+  return res;
+}
+
+/** The number of least significant bits of `a` that are known to be zero. */
+unsigned countTrailingZeros(const Abstraction& a)
+{
+  unsigned size = a.d_known.getSize();
+  unsigned res = 0;
+  while (res < size && a.d_known.isBitSet(res) && !a.d_value.isBitSet(res))
+  {
+    ++res;
+  }
+  return res;
+}
+
+/** Whether `value` fits into `size` bits. */
+bool fits(const Integer& value, unsigned size)
+{
+  return value < Integer(1).multiplyByPow2(size);
+}
+
+/** The known bits of a + b, computed bit by bit with the carry. */
+void addKnownBits(const Abstraction& a,
+                  const Abstraction& b,
+                  Abstraction& res)
+{
+  bool carryKnown = true;
+  bool carry = false;
+  for (unsigned i = 0, size = a.d_known.getSize(); i < size; ++i)
+  {
+    bool ka = a.d_known.isBitSet(i), va = a.d_value.isBitSet(i);
+    bool kb = b.d_known.isBitSet(i), vb = b.d_value.isBitSet(i);
+    if (ka && kb && carryKnown)
+    {
+      res.d_known = res.d_known.setBit(i, true);
+      res.d_value = res.d_value.setBit(i, va ^ vb ^ carry);
+      carry = (va && vb) || (carry && (va ^ vb));
+      continue;
+    }
+    // The carry out is the majority of the inputs, which is known if two of
+    // them are known to be equal.
+    unsigned zeros = (ka && !va) + (kb && !vb) + (carryKnown && !carry);
+    unsigned ones = (ka && va) + (kb && vb) + (carryKnown && carry);
+    carryKnown = zeros >= 2 || ones >= 2;
+    carry = ones >= 2;
+  }
+}
+
+/**
+ * The abstraction of `node` computed from the abstractions of its children.
+ * Unsupported operators yield an unconstrained abstraction.
+ */
+Abstraction forward(TNode node, const AbstractionMap& abs)
+{
+  unsigned size = bv::utils::getSize(node);
+  Abstraction res(size);
+  BitVector ones = BitVector::mkOnes(size);
+  auto child = [&](size_t i) -> const Abstraction& { return abs.at(node[i]); };
+
+  switch (node.getKind())
+  {
+    case kind::CONST_BITVECTOR: return Abstraction(node.getConst<BitVector>());
+
+    case kind::BITVECTOR_NOT:
+      res.d_known = child(0).d_known;
+      res.d_value = ~child(0).d_value & res.d_known;
+      res.d_lo = ~child(0).d_hi;
+      res.d_hi = ~child(0).d_lo;
+      break;
+
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    {
+      bool isAnd = node.getKind() == kind::BITVECTOR_AND;
+      res = child(0);
+      for (size_t i = 1, n = node.getNumChildren(); i < n; ++i)
+      {
+        const Abstraction& c = child(i);
+        // The bits known to be the absorbing element of the operator.
+        BitVector absorbing = isAnd ? (res.d_known & ~res.d_value)
+                                          | (c.d_known & ~c.d_value)
+                                    : (res.d_known & res.d_value)
+                                          | (c.d_known & c.d_value);
+        res.d_known = (res.d_known & c.d_known) | absorbing;
+        res.d_value = isAnd ? res.d_value & c.d_value : res.d_value | c.d_value;
+        if (isAnd)
+        {
+          res.d_lo = BitVector::mkZero(size);
+          res.d_hi = c.d_hi.unsignedLessThan(res.d_hi) ? c.d_hi : res.d_hi;
+        }
+        else
+        {
+          res.d_lo = res.d_lo.unsignedLessThan(c.d_lo) ? c.d_lo : res.d_lo;
+          res.d_hi = ones;
+        }
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_XOR:
+    {
+      res.d_known = child(0).d_known;
+      res.d_value = child(0).d_value;
+      for (size_t i = 1, n = node.getNumChildren(); i < n; ++i)
+      {
+        res.d_known = res.d_known & child(i).d_known;
+        res.d_value = (res.d_value ^ child(i).d_value) & res.d_known;
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_CONCAT:
+    {
+      res = child(0);
+      for (size_t i = 1, n = node.getNumChildren(); i < n; ++i)
+      {
+        res.d_known = res.d_known.concat(child(i).d_known);
+        res.d_value = res.d_value.concat(child(i).d_value);
+        res.d_lo = res.d_lo.concat(child(i).d_lo);
+        res.d_hi = res.d_hi.concat(child(i).d_hi);
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned high = bv::utils::getExtractHigh(node);
+      unsigned low = bv::utils::getExtractLow(node);
+      res.d_known = child(0).d_known.extract(high, low);
+      res.d_value = child(0).d_value.extract(high, low);
+      if (low == 0 && fits(child(0).d_hi.toInteger(), size))
+      {
+        res.d_lo = child(0).d_lo.extract(high, low);
+        res.d_hi = child(0).d_hi.extract(high, low);
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_ZERO_EXTEND:
+    {
+      unsigned n = node.getOperator().getConst<BitVectorZeroExtend>();
+      res.d_known = BitVector::mkOnes(n).concat(child(0).d_known);
+      res.d_value = child(0).d_value.zeroExtend(n);
+      res.d_lo = child(0).d_lo.zeroExtend(n);
+      res.d_hi = child(0).d_hi.zeroExtend(n);
+      break;
+    }
+
+    case kind::BITVECTOR_SIGN_EXTEND:
+    {
+      unsigned n = node.getOperator().getConst<BitVectorSignExtend>();
+      unsigned msb = bv::utils::getSize(node[0]) - 1;
+      if (child(0).d_known.isBitSet(msb))
+      {
+        res.d_known = BitVector::mkOnes(n).concat(child(0).d_known);
+        res.d_value = child(0).d_value.signExtend(n);
+      }
+      else
+      {
+        res.d_known = child(0).d_known.zeroExtend(n);
+        res.d_value = child(0).d_value.zeroExtend(n);
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    {
+      if (!node[1].isConst())
+      {
+        break;
+      }
+      const BitVector& shift = node[1].getConst<BitVector>();
+      // The bits shifted in are known zeros.
+      BitVector mask = ones;
+      if (node.getKind() == kind::BITVECTOR_SHL)
+      {
+        res.d_known = child(0).d_known.leftShift(shift) | ~mask.leftShift(shift);
+        res.d_value = child(0).d_value.leftShift(shift);
+      }
+      else
+      {
+        res.d_known = child(0).d_known.logicalRightShift(shift)
+                      | ~mask.logicalRightShift(shift);
+        res.d_value = child(0).d_value.logicalRightShift(shift);
+        res.d_lo = child(0).d_lo.logicalRightShift(shift);
+        res.d_hi = child(0).d_hi.logicalRightShift(shift);
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_PLUS:
+    {
+      res = child(0);
+      for (size_t i = 1, n = node.getNumChildren(); i < n; ++i)
+      {
+        const Abstraction& c = child(i);
+        Abstraction sum(size);
+        addKnownBits(res, c, sum);
+        if (fits(res.d_hi.toInteger() + c.d_hi.toInteger(), size))
+        {
+          sum.d_lo = res.d_lo + c.d_lo;
+          sum.d_hi = res.d_hi + c.d_hi;
+        }
+        res = sum;
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_MULT:
+    {
+      unsigned zeros = 0;
+      Integer lo(1), hi(1);
+      for (size_t i = 0, n = node.getNumChildren(); i < n; ++i)
+      {
+        zeros += countTrailingZeros(child(i));
+        lo *= child(i).d_lo.toInteger();
+        hi *= child(i).d_hi.toInteger();
+      }
+      zeros = std::min(zeros, size);
+      if (zeros > 0)
+      {
+        res.d_known = placeBits(BitVector::mkOnes(zeros), 0, size);
+      }
+      if (fits(hi, size))
+      {
+        res.d_lo = BitVector(size, lo);
+        res.d_hi = BitVector(size, hi);
+      }
+      break;
+    }
+
+    case kind::BITVECTOR_UDIV:
+      // Division by zero yields all ones, hence only a positive divisor
+      // bounds the result.
+      if (child(1).d_lo.toInteger().isZero())
+      {
+        break;
+      }
+      res.d_lo = child(0).d_lo.unsignedDivTotal(child(1).d_hi);
+      res.d_hi = child(0).d_hi.unsignedDivTotal(child(1).d_lo);
+      break;
+
+    case kind::BITVECTOR_UREM:
+      // The remainder is at most the dividend, also for a zero divisor.
+      res.d_hi = child(0).d_hi;
+      if (!child(1).d_lo.toInteger().isZero())
+      {
+        BitVector max = child(1).d_hi - BitVector::mkOne(size);
+        res.d_hi = max.unsignedLessThan(res.d_hi) ? max : res.d_hi;
+      }
+      break;
+
+    case kind::ITE:
+    case kind::BITVECTOR_ITE:
+    {
+      const Abstraction& t = child(1);
+      const Abstraction& e = child(2);
+      res.d_known = t.d_known & e.d_known & ~(t.d_value ^ e.d_value);
+      res.d_value = t.d_value & res.d_known;
+      res.d_lo = t.d_lo.unsignedLessThan(e.d_lo) ? t.d_lo : e.d_lo;
+      res.d_hi = t.d_hi.unsignedLessThan(e.d_hi) ? e.d_hi : t.d_hi;
+      break;
+    }
+
+    default: break;
+  }
+  return res;
+}
+
+/**
+ * Propagate the abstraction of `node` to its children. Sets `changed` if the
+ * abstraction of a child changed, and returns false on conflict.
+ */
+bool backward(TNode node, AbstractionMap& abs, bool& changed)
+{
+  // Copy, since refining the children may rehash the map.
+  Abstraction a = abs.at(node);
+  unsigned size = bv::utils::getSize(node);
+
+  switch (node.getKind())
+  {
+    case kind::BITVECTOR_NOT:
+    {
+      Abstraction c(size);
+      c.d_known = a.d_known;
+      c.d_value = ~a.d_value & a.d_known;
+      c.d_lo = ~a.d_hi;
+      c.d_hi = ~a.d_lo;
+      return refine(abs, node[0], c, changed);
+    }
+
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    {
+      // Result bits that are one (zero) for bvand (bvor) are one (zero) in
+      // all operands, and the result is a lower (upper) bound of all operands.
+      bool isAnd = node.getKind() == kind::BITVECTOR_AND;
+      Abstraction c(size);
+      c.d_known = a.d_known & (isAnd ? a.d_value : ~a.d_value);
+      c.d_value = isAnd ? c.d_known : BitVector::mkZero(size);
+      if (isAnd)
+      {
+        c.d_lo = a.d_lo;
+      }
+      else
+      {
+        c.d_hi = a.d_hi;
+      }
+      for (const Node& n : node)
+      {
+        if (!refine(abs, n, c, changed))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    case kind::BITVECTOR_XOR:
+    {
+      if (node.getNumChildren() != 2)
+      {
+        return true;
+      }
+      for (size_t i = 0; i < 2; ++i)
+      {
+        const Abstraction& other = abs.at(node[1 - i]);
+        Abstraction c(size);
+        c.d_known = a.d_known & other.d_known;
+        c.d_value = (a.d_value ^ other.d_value) & c.d_known;
+        if (!refine(abs, node[i], c, changed))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    case kind::BITVECTOR_CONCAT:
+    {
+      unsigned low = 0;
+      for (size_t i = node.getNumChildren(); i-- > 0;)
+      {
+        unsigned csize = bv::utils::getSize(node[i]);
+        Abstraction c(csize);
+        c.d_known = a.d_known.extract(low + csize - 1, low);
+        c.d_value = a.d_value.extract(low + csize - 1, low);
+        if (!refine(abs, node[i], c, changed))
+        {
+          return false;
+        }
+        low += csize;
+      }
+      return true;
+    }
+
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned low = bv::utils::getExtractLow(node);
+      unsigned csize = bv::utils::getSize(node[0]);
+      Abstraction c(csize);
+      c.d_known = placeBits(a.d_known, low, csize);
+      c.d_value = placeBits(a.d_value, low, csize);
+      return refine(abs, node[0], c, changed);
+    }
+
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+    {
+      unsigned csize = bv::utils::getSize(node[0]);
+      Abstraction c(csize);
+      c.d_known = a.d_known.extract(csize - 1, 0);
+      c.d_value = a.d_value.extract(csize - 1, 0);
+      if (node.getKind() == kind::BITVECTOR_ZERO_EXTEND)
+      {
+        if (fits(a.d_hi.toInteger(), csize))
+        {
+          c.d_hi = a.d_hi.extract(csize - 1, 0);
+        }
+        // The high bits of a zero-extended term are zero.
+        if (!fits(a.d_lo.toInteger(), csize))
+        {
+          return false;
+        }
+        c.d_lo = a.d_lo.extract(csize - 1, 0);
+      }
+      return refine(abs, node[0], c, changed);
+    }
+
+    case kind::BITVECTOR_PLUS:
+    {
+      // x + c = v implies x = v - c.
+      if (!a.isConst() || node.getNumChildren() != 2)
+      {
+        return true;
+      }
+      for (size_t i = 0; i < 2; ++i)
+      {
+        const Abstraction& other = abs.at(node[1 - i]);
+        if (other.isConst()
+            && !refine(abs,
+                       node[i],
+                       Abstraction(a.d_value - other.d_value),
+                       changed))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    default: return true;
+  }
+}
+
+/**
+ * Refine the abstractions with the information of the (possibly negated)
+ * top-level atom `assertion`, descending into conjunctions. Sets `used` if
+ * some information was taken from it, and returns false on conflict.
+ */
+bool addSeed(TNode assertion, AbstractionMap& abs, bool& used)
+{
+  bool pol = assertion.getKind() != kind::NOT;
+  TNode atom = pol ? assertion : assertion[0];
+  Kind k = atom.getKind();
+
+  if (k == kind::AND && pol)
+  {
+    for (const Node& n : atom)
+    {
+      if (!addSeed(n, abs, used))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if ((k != kind::EQUAL && k != kind::BITVECTOR_ULT && k != kind::BITVECTOR_ULE)
+      || !atom[0].getType().isBitVector()
+      || atom[0].isConst() == atom[1].isConst())
+  {
+    return true;
+  }
+
+  // Normalize to `t` compared to constant `c`, where `constLeft` indicates
+  // that `c` is the left operand.
+  bool constLeft = atom[0].isConst();
+  TNode t = constLeft ? atom[1] : atom[0];
+  const BitVector& c = atom[constLeft ? 0 : 1].getConst<BitVector>();
+  unsigned size = c.getSize();
+  BitVector zero = BitVector::mkZero(size);
+  BitVector ones = BitVector::mkOnes(size);
+  BitVector one = BitVector::mkOne(size);
+  Abstraction a(size);
+  bool changed = false;
+
+  if (k == kind::EQUAL)
+  {
+    if (pol)
+    {
+      a = Abstraction(c);
+    }
+    else if (size == 1)
+    {
+      a = Abstraction(~c);
+    }
+    else
+    {
+      return true;
+    }
+  }
+  else
+  {
+    // Bring the comparison into the form `t < c`, `t <= c`, `c < t` or
+    // `c <= t` by flipping negated atoms.
+    bool strict = k == kind::BITVECTOR_ULT;
+    if (!pol)
+    {
+      strict = !strict;
+      constLeft = !constLeft;
+    }
+    if (constLeft)
+    {
+      // c < t or c <= t
+      if (strict && c == ones)
+      {
+        return false;
+      }
+      a.d_lo = strict ? c + one : c;
+    }
+    else
+    {
+      // t < c or t <= c
+      if (strict && c == zero)
+      {
+        return false;
+      }
+      a.d_hi = strict ? c - one : c;
+    }
+  }
+  used = true;
+  return refine(abs, t, a, changed);
+}
+
+/**
+ * Decide the atom `node` from the abstractions of its operands. Returns the
+ * null node if it cannot be decided.
+ */
+Node decide(TNode node, const AbstractionMap& abs)
+{
+  Kind k = node.getKind();
+  if (k != kind::EQUAL && k != kind::BITVECTOR_ULT && k != kind::BITVECTOR_ULE
+      && k != kind::BITVECTOR_SLT && k != kind::BITVECTOR_SLE)
+  {
+    return Node::null();
+  }
+  if (!node[0].getType().isBitVector())
+  {
+    return Node::null();
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  const Abstraction& a = abs.at(node[0]);
+  const Abstraction& b = abs.at(node[1]);
+
+  if (k == kind::EQUAL)
+  {
+    BitVector both = a.d_known & b.d_known;
+    if ((both & (a.d_value ^ b.d_value)) != BitVector::mkZero(both.getSize())
+        || a.d_hi.unsignedLessThan(b.d_lo) || b.d_hi.unsignedLessThan(a.d_lo))
+    {
+      return nm->mkConst<bool>(false);
+    }
+    return Node::null();
+  }
+
+  if (k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SLE)
+  {
+    // With known signs, operands of different sign are ordered by their
+    // sign, and operands of the same sign like unsigned values.
+    unsigned msb = a.d_known.getSize() - 1;
+    if (!a.d_known.isBitSet(msb) || !b.d_known.isBitSet(msb))
+    {
+      return Node::null();
+    }
+    bool na = a.d_value.isBitSet(msb);
+    if (na != b.d_value.isBitSet(msb))
+    {
+      return nm->mkConst<bool>(na);
+    }
+  }
+
+  bool strict = k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_SLT;
+  if (strict ? a.d_hi.unsignedLessThan(b.d_lo)
+             : a.d_hi.unsignedLessThanEq(b.d_lo))
+  {
+    return nm->mkConst<bool>(true);
+  }
+  if (strict ? b.d_hi.unsignedLessThanEq(a.d_lo)
+             : b.d_hi.unsignedLessThan(a.d_lo))
+  {
+    return nm->mkConst<bool>(false);
+  }
+  return Node::null();
+}
+
+/**
+ * Replace the known bits of `node` by constants, i.e., rewrite it into a
+ * concatenation of constants and extracts of its unknown bits.
+ */
+Node fixBits(TNode node, const Abstraction& a)
+{
+  std::vector<Node> parts;
+  for (int i = bv::utils::getSize(node) - 1; i >= 0;)
+  {
+    bool known = a.d_known.isBitSet(i);
+    int j = i;
+    while (j > 0 && a.d_known.isBitSet(j - 1) == known)
+    {
+      --j;
+    }
+    parts.push_back(known ? bv::utils::mkConst(a.d_value.extract(i, j))
+                          : bv::utils::mkExtract(node, i, j));
+    i = j - 1;
+  }
+  return parts.size() == 1 ? parts[0] : bv::utils::mkConcat(parts);
+}
+
+/** The number of simplifications of each kind made by simplify(). */
+struct SimplifyCounts
+{
+  uint64_t d_constants = 0;
+  uint64_t d_decided = 0;
+  uint64_t d_fixedBits = 0;
+};
+
+/**
+ * Simplify `node` with the abstractions of its bit-vector terms, and count
+ * the simplifications in `counts`.
+ */
+Node simplify(TNode node,
+              const AbstractionMap& abs,
+              NodeMap& cache,
+              SimplifyCounts& counts)
+{
+  std::vector<TNode> visit{node};
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (cache.find(cur) != cache.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    bool isBV = cur.getType().isBitVector();
+    if (cur.isClosure() || cur.isConst()
+        || (isBV && abs.find(cur) == abs.end()))
+    {
+      cache[cur] = cur;
+      visit.pop_back();
+      continue;
+    }
+    if (isBV && abs.at(cur).isConst())
+    {
+      cache[cur] = bv::utils::mkConst(abs.at(cur).d_value);
+      ++counts.d_constants;
+      visit.pop_back();
+      continue;
+    }
+    Node decided = decide(cur, abs);
+    if (!decided.isNull())
+    {
+      cache[cur] = decided;
+      ++counts.d_decided;
+      visit.pop_back();
+      continue;
+    }
+
+    bool ready = true;
+    for (const Node& n : cur)
+    {
+      if (cache.find(n) == cache.end())
+      {
+        visit.push_back(n);
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    visit.pop_back();
+
+    Node res = cur;
+    if (cur.getNumChildren() > 0)
+    {
+      NodeBuilder<> nb(cur.getKind());
+      if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        nb << cur.getOperator();
+      }
+      for (const Node& n : cur)
+      {
+        nb << cache.at(n);
+      }
+      res = nb;
+    }
+    if (isBV && (cur.isVar() || cur.getKind() == kind::BITVECTOR_EXTRACT)
+        && !abs.at(cur).d_known.toInteger().isZero())
+    {
+      const Abstraction& a = abs.at(cur);
+      res = fixBits(res, a);
+      for (unsigned i = 0, size = a.d_known.getSize(); i < size; ++i)
+      {
+        counts.d_fixedBits += a.d_known.isBitSet(i) ? 1 : 0;
+      }
+    }
+    cache[cur] = res;
+  }
+  return cache.at(node);
+}
+
+}  // namespace
+
+BvKnownBits::BvKnownBits(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "bv-known-bits"){};
+
+BvKnownBits::Statistics::Statistics()
+    : d_numSeeds("preprocessing::passes::BvKnownBits::numSeeds", 0),
+      d_numConstants("preprocessing::passes::BvKnownBits::numConstants", 0),
+      d_numDecidedAtoms("preprocessing::passes::BvKnownBits::numDecidedAtoms",
+                        0),
+      d_numFixedBits("preprocessing::passes::BvKnownBits::numFixedBits", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numSeeds);
+  smtStatisticsRegistry()->registerStat(&d_numConstants);
+  smtStatisticsRegistry()->registerStat(&d_numDecidedAtoms);
+  smtStatisticsRegistry()->registerStat(&d_numFixedBits);
+}
+
+BvKnownBits::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numSeeds);
+  smtStatisticsRegistry()->unregisterStat(&d_numConstants);
+  smtStatisticsRegistry()->unregisterStat(&d_numDecidedAtoms);
+  smtStatisticsRegistry()->unregisterStat(&d_numFixedBits);
+}
+
+PreprocessingPassResult BvKnownBits::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager* nm = NodeManager::currentNM();
+
+  // Collect the bit-vector terms of the assertions, children before parents.
+  std::vector<Node> terms;
+  AbstractionMap abs;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  for (const Node& assertion : assertionsToPreprocess->ref())
+  {
+    std::vector<std::pair<TNode, bool>> visit{{assertion, false}};
+    while (!visit.empty())
+    {
+      std::pair<TNode, bool> cur = visit.back();
+      visit.pop_back();
+      if (cur.second)
+      {
+        if (cur.first.getType().isBitVector())
+        {
+          terms.push_back(cur.first);
+          abs.emplace(cur.first, Abstraction(bv::utils::getSize(cur.first)));
+        }
+        continue;
+      }
+      if (!visited.insert(cur.first).second)
+      {
+        continue;
+      }
+      visit.emplace_back(cur.first, true);
+      if (!cur.first.isClosure())
+      {
+        for (const Node& n : cur.first)
+        {
+          visit.emplace_back(n, false);
+        }
+      }
+    }
+  }
+  if (terms.empty())
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  // Seed the abstractions from the top-level atoms, and remember the
+  // assertions they were taken from.
+  bool conflict = false;
+  std::vector<bool> isSeed(assertionsToPreprocess->size(), false);
+  for (size_t i = 0, n = assertionsToPreprocess->size(); i < n && !conflict;
+       ++i)
+  {
+    bool used = false;
+    conflict = !addSeed((*assertionsToPreprocess)[i], abs, used);
+    isSeed[i] = used;
+    if (used)
+    {
+      ++d_statistics.d_numSeeds;
+    }
+  }
+
+  // Propagate forward and backward until a fixpoint is reached.
+  bool changed = true;
+  for (unsigned round = 0; round < s_maxRounds && changed && !conflict;
+       ++round)
+  {
+    changed = false;
+    for (const Node& t : terms)
+    {
+      if (!refine(abs, t, forward(t, abs), changed))
+      {
+        conflict = true;
+        break;
+      }
+    }
+    for (size_t i = terms.size(); i-- > 0 && !conflict;)
+    {
+      conflict = !backward(terms[i], abs, changed);
+    }
+  }
+
+  if (conflict)
+  {
+    assertionsToPreprocess->clear();
+    assertionsToPreprocess->push_back(nm->mkConst<bool>(false));
+    return PreprocessingPassResult::CONFLICT;
+  }
+
+  NodeMap cache;
+  SimplifyCounts counts;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    if (isSeed[i])
+    {
+      continue;
+    }
+    Node cur = (*assertionsToPreprocess)[i];
+    Node res = simplify(cur, abs, cache, counts);
+    if (res != cur)
+    {
+      assertionsToPreprocess->replace(i, Rewriter::rewrite(res));
+    }
+  }
+  d_statistics.d_numConstants += counts.d_constants;
+  d_statistics.d_numDecidedAtoms += counts.d_decided;
+  d_statistics.d_numFixedBits += counts.d_fixedBits;
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file bv_known_bits.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The BvKnownBits preprocessing pass
+ **
+ ** Computes the known bits and the unsigned range of bit-vector terms from
+ ** the top-level assertions by propagation to a fixpoint, and simplifies the
+ ** remaining assertions with them. Can be enabled via option
+ ** `--bv-known-bits`.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__BV_KNOWN_BITS_H
+#define CVC4__PREPROCESSING__PASSES__BV_KNOWN_BITS_H
+
+#include "preprocessing/preprocessing_pass.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * Top-level assertions of the form (= t c), (bvult t c), (bvule c t), etc.,
+ * with constant c, fix bits or bound the range of term t. These are
+ * propagated forward through the operators of the assertions (e.g., the
+ * known zeros of an operand of bvand are zeros of the result) and backward
+ * from terms to their operands (e.g., the known bits of an extract are bits
+ * of its operand), alternately until nothing changes.
+ *
+ * The other assertions are then simplified: terms whose bits are all known
+ * are replaced by constants, comparisons decided by the ranges of their
+ * operands are replaced by true or false, and the known bits of variables
+ * and extracts are fixed by replacing them with a concatenation of constants
+ * and extracts of the unknown bits. The assertions the information was taken
+ * from are kept as they are, so that models of variables remain correct.
+ */
+class BvKnownBits : public PreprocessingPass
+{
+ public:
+  BvKnownBits(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  struct Statistics
+  {
+    /** number of assertions the abstractions were seeded from */
+    IntStat d_numSeeds;
+    /** number of terms replaced by constants */
+    IntStat d_numConstants;
+    /** number of atoms replaced by true or false */
+    IntStat d_numDecidedAtoms;
+    /** number of bits of variables and extracts replaced by constants */
+    IntStat d_numFixedBits;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__BV_KNOWN_BITS_H */
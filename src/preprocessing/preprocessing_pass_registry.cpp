@@ -30,6 +30,7 @@
 #include "preprocessing/passes/bv_eager_atoms.h"
 #include "preprocessing/passes/bv_gauss.h"
 #include "preprocessing/passes/bv_intro_pow2.h"
+#include "preprocessing/passes/bv_known_bits.h"
 #include "preprocessing/passes/bv_to_bool.h"
 #include "preprocessing/passes/bv_to_int.h"
 #include "preprocessing/passes/extended_rewriter_pass.h"
@@ -132,6 +133,7 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("sygus-infer", callCtor<SygusInference>);
   registerPassInfo("bv-to-bool", callCtor<BVToBool>);
   registerPassInfo("bv-intro-pow2", callCtor<BvIntroPow2>);
+  registerPassInfo("bv-known-bits", callCtor<BvKnownBits>);
   registerPassInfo("sort-inference", callCtor<SortInferencePass>);
   registerPassInfo("sep-skolem-emp", callCtor<SepSkolemEmp>);
   registerPassInfo("rewrite", callCtor<Rewrite>);
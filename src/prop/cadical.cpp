@@ -86,6 +86,11 @@ ClauseId CadicalSolver::addClause(SatClause& clause, bool removable)
   {
     d_solver->add(toCadicalLit(lit));
   }
+  /* As in MiniSat, removable clauses (lemmas) survive pop(). */
+  if (!removable && !d_activationLits.empty())
+  {
+    d_solver->add(toCadicalLit(~d_activationLits.back()));
+  }
   d_solver->add(0);
   ++d_statistics.d_numClauses;
   return ClauseIdError;
@@ -114,6 +119,7 @@ SatValue CadicalSolver::solve()
 {
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
+  assumeActivationLits();
   SatValue res = toSatValue(d_solver->solve());
   d_inSatMode = (res == SAT_VALUE_TRUE);
   ++d_statistics.d_numSatCalls;
@@ -129,6 +135,7 @@ SatValue CadicalSolver::solve(const std::vector<SatLiteral>& assumptions)
 {
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
+  assumeActivationLits();
   for (const SatLiteral& lit : assumptions)
   {
     d_solver->assume(toCadicalLit(lit));
@@ -157,6 +164,29 @@ void CadicalSolver::getUnsatAssumptions(std::vector<SatLiteral>& assumptions)
   }
 }
 
+void CadicalSolver::push()
+{
+  d_activationLits.push_back(SatLiteral(newVar()));
+  d_inSatMode = false;
+}
+
+void CadicalSolver::pop()
+{
+  Assert(!d_activationLits.empty());
+  d_solver->add(toCadicalLit(~d_activationLits.back()));
+  d_solver->add(0);
+  d_activationLits.pop_back();
+  d_inSatMode = false;
+}
+
+void CadicalSolver::assumeActivationLits()
+{
+  for (const SatLiteral& lit : d_activationLits)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+}
+
 void CadicalSolver::interrupt() { d_solver->terminate(); }
 
 SatValue CadicalSolver::value(SatLiteral l)
@@ -173,7 +203,7 @@ SatValue CadicalSolver::modelValue(SatLiteral l)
 
 unsigned CadicalSolver::getAssertionLevel() const
 {
-  Unreachable() << "CaDiCaL does not support assertion levels.";
+  return d_activationLits.size();
 }
 
 bool CadicalSolver::ok() const { return d_inSatMode; }
@@ -53,6 +53,19 @@ class CadicalSolver : public SatSolver
   bool setPropagateOnly() override;
   void getUnsatAssumptions(std::vector<SatLiteral>& assumptions) override;
 
+  /**
+   * Emulate assertion levels with activation literals. Clauses that are not
+   * removable are guarded by the activation literal of the innermost level,
+   * which is assumed by every call to solve().
+   */
+  void push() override;
+
+  /**
+   * Retract the clauses of the innermost level by permanently asserting the
+   * negation of its activation literal.
+   */
+  void pop() override;
+
   void interrupt() override;
 
   SatValue value(SatLiteral l) override;
@@ -74,6 +87,8 @@ class CadicalSolver : public SatSolver
    * Note: Split out to not call virtual functions in constructor.
    */
   void init();
+  /** Assume the activation literals of all open assertion levels. */
+  void assumeActivationLits();
 
   std::unique_ptr<CaDiCaL::Solver> d_solver;
   /**
@@ -81,6 +96,8 @@ class CadicalSolver : public SatSolver
    * query the solver if a given assumption is false.
    */
   std::vector<SatLiteral> d_assumptions;
+  /** The activation literals of the currently open assertion levels. */
+  std::vector<SatLiteral> d_activationLits;
 
   unsigned d_nextVarIdx;
   bool d_inSatMode;
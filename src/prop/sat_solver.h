@@ -116,6 +116,15 @@ public:
     Unimplemented() << "getUnsatAssumptions not implemented";
   }
 
+  /**
+   * Open a new assertion level. Clauses that are not removable and added
+   * after push() are retracted by the matching pop().
+   */
+  virtual void push() { Unimplemented() << "push not implemented"; }
+
+  /** Close the innermost assertion level opened by push(). */
+  virtual void pop() { Unimplemented() << "pop not implemented"; }
+
 };/* class SatSolver */
 
 
@@ -153,9 +162,9 @@ class CDCLTSatSolverInterface : public SatSolver
                           CVC4::context::UserContext* userContext,
                           ProofNodeManager* pnm) = 0;
 
-  virtual void push() = 0;
+  void push() override = 0;
 
-  virtual void pop() = 0;
+  void pop() override = 0;
 
   /*
    * Reset the decisions in the DPLL(T) SAT solver at the current assertion
@@ -199,6 +199,11 @@ bool ProcessAssertions::apply(Assertions& as)
     d_passes["bv-intro-pow2"]->apply(&assertions);
   }
 
+  if (options::bvKnownBits())
+  {
+    d_passes["bv-known-bits"]->apply(&assertions);
+  }
+
   // Lift bit-vectors of size 1 to bool
   if (options::bitvectorToBool())
   {
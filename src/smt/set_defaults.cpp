@@ -119,6 +119,14 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
           "only supported for QF_BV. Try --bitblast=lazy.");
     }
 
+    if (options::incrementalSolving()
+        && options::bvSatSolver() == options::SatSolverMode::KISSAT)
+    {
+      throw OptionException(
+          "Incremental eager bit-blasting is not supported with Kissat. "
+          "Try --bv-sat-solver=cadical.");
+    }
+
     // Force lazy solver since we don't handle EAGER_ATOMS in the
     // BVSolver::BITBLAST solver.
     options::bvSolver.set(options::BVSolver::LAZY);
@@ -473,6 +481,18 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
       options::bvIntroducePow2.set(false);
     }
 
+    if (options::bvKnownBits())
+    {
+      if (options::bvKnownBits.wasSetByUser())
+      {
+        throw OptionException("bv-known-bits not supported with unsat cores");
+      }
+      Notice() << "SmtEngine: turning off bv-known-bits to support "
+                  "unsat-cores"
+               << std::endl;
+      options::bvKnownBits.set(false);
+    }
+
     if (options::repeatSimp())
     {
       if (options::repeatSimp.wasSetByUser())
@@ -1268,6 +1288,17 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
       options::relevanceFilter.set(true);
     }
   }
+  if (logic.isTheoryEnabled(THEORY_STRINGS) && options::stringRegExpRlv()
+      && !options::relevanceFilter())
+  {
+    if (options::relevanceFilter.wasSetByUser())
+    {
+      Warning() << "SmtEngine: turning on relevance filtering to support "
+                   "--re-rlv"
+                << std::endl;
+    }
+    options::relevanceFilter.set(true);
+  }
 
   // For now, these array theory optimizations do not support model-building
   if (options::produceModels() || options::produceAssignments()
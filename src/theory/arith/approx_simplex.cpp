@@ -18,7 +18,9 @@
 
 #include <math.h>
 #include <cfloat>
+#include <atomic>
 #include <cmath>
+#include <thread>
 #include <unordered_set>
 
 #include "base/output.h"
@@ -153,6 +155,9 @@ ApproximateStatistics::ApproximateStatistics()
   ,  d_gaussianElimConstructTime("z::approx::gaussianElimConstruct::time")
   ,  d_gaussianElimConstruct("z::approx::gaussianElimConstruct::calls",0)
   ,  d_averageGuesses("z::approx::averageGuesses")
+  ,  d_floatPivots("z::approx::float::pivots", 0)
+  ,  d_floatRaces("z::approx::float::race::runs", 0)
+  ,  d_floatRaceSteepestWins("z::approx::float::race::steepestWins", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_branchMaxDepth);
   smtStatisticsRegistry()->registerStat(&d_branchesMaxOnAVar);
@@ -161,6 +166,9 @@ ApproximateStatistics::ApproximateStatistics()
   smtStatisticsRegistry()->registerStat(&d_gaussianElimConstruct);
 
   smtStatisticsRegistry()->registerStat(&d_averageGuesses);
+  smtStatisticsRegistry()->registerStat(&d_floatPivots);
+  smtStatisticsRegistry()->registerStat(&d_floatRaces);
+  smtStatisticsRegistry()->registerStat(&d_floatRaceSteepestWins);
 }
 
 ApproximateStatistics::~ApproximateStatistics(){
@@ -171,6 +179,9 @@ ApproximateStatistics::~ApproximateStatistics(){
   smtStatisticsRegistry()->unregisterStat(&d_gaussianElimConstruct);
 
   smtStatisticsRegistry()->unregisterStat(&d_averageGuesses);
+  smtStatisticsRegistry()->unregisterStat(&d_floatPivots);
+  smtStatisticsRegistry()->unregisterStat(&d_floatRaces);
+  smtStatisticsRegistry()->unregisterStat(&d_floatRaceSteepestWins);
 }
 
 Integer ApproximateSimplex::s_defaultMaxDenom(1<<26);
@@ -327,6 +338,56 @@ Maybe<Rational> ApproximateSimplex::estimateWithCFE(double d)
   return estimateWithCFE(d, s_defaultMaxDenom);
 }
 
+DeltaRational ApproximateSimplex::estimateAssignment(ArithVar vi,
+                                                     double newAssign) const
+{
+  if (d_vars.hasLowerBound(vi)
+      && roughlyEqual(newAssign,
+                      d_vars.getLowerBound(vi).approx(SMALL_FIXED_DELTA)))
+  {
+    return d_vars.getLowerBound(vi);
+  }
+  else if (d_vars.hasUpperBound(vi)
+           && roughlyEqual(newAssign,
+                           d_vars.getUpperBound(vi).approx(SMALL_FIXED_DELTA)))
+  {
+    return d_vars.getUpperBound(vi);
+  }
+  const DeltaRational& oldAssign = d_vars.getAssignment(vi);
+
+  double rounded = round(newAssign);
+  if (roughlyEqual(newAssign, rounded))
+  {
+    newAssign = rounded;
+  }
+
+  DeltaRational proposal;
+  if (Maybe<Rational> maybe_new = estimateWithCFE(newAssign))
+  {
+    proposal = maybe_new.value();
+  }
+  else
+  {
+    // failed to estimate the old value. defaulting to the current.
+    proposal = oldAssign;
+  }
+
+  if (roughlyEqual(newAssign, oldAssign.approx(SMALL_FIXED_DELTA)))
+  {
+    proposal = oldAssign;
+  }
+
+  if (d_vars.strictlyLessThanLowerBound(vi, proposal))
+  {
+    proposal = d_vars.getLowerBound(vi);
+  }
+  else if (d_vars.strictlyGreaterThanUpperBound(vi, proposal))
+  {
+    proposal = d_vars.getUpperBound(vi);
+  }
+  return proposal;
+}
+
 class ApproxNoOp : public ApproximateSimplex {
 public:
   ApproxNoOp(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s)
@@ -362,6 +423,582 @@ public:
   double sumInfeasibilities(bool mip) const override { return 0.0; }
 };
 
+/**
+ * A bounded primal simplex over doubles that minimizes the sum of
+ * infeasibilities of the basic variables. The tableau is stored densely as
+ *   d_tableau[r * d_numVars + j]
+ * for the coefficient of variable j in the row of the basic variable of row r.
+ * Its result is only a candidate basis, which is repaired and verified in
+ * exact arithmetic by the caller (see AttemptSolutionSDP).
+ */
+class ApproxFloat : public ApproximateSimplex
+{
+ public:
+  /** How the entering variable is chosen. */
+  enum class PivotRule
+  {
+    /** The largest component of the gradient (Dantzig's rule). */
+    LARGEST_COEFFICIENT,
+    /** The largest component of the gradient relative to its column norm. */
+    STEEPEST_EDGE
+  };
+
+  ApproxFloat(const ArithVariables& v,
+              TreeLog& l,
+              ApproximateStatistics& s,
+              PivotRule rule = PivotRule::LARGEST_COEFFICIENT);
+  ~ApproxFloat() {}
+
+  /**
+   * Runs the simplex search without touching the shared statistics, so that
+   * it may be called from another thread. The search gives up with
+   * LinUnknown as soon as the stop flag, if any, is set.
+   */
+  LinResult search();
+  void setStopFlag(const std::atomic<bool>* stop) { d_stop = stop; }
+  /** The number of pivots performed by search(). */
+  int64_t getPivots() const { return d_pivots; }
+
+  LinResult solveRelaxation() override;
+  Solution extractRelaxation() const override;
+
+  ArithRatPairVec heuristicOptCoeffs() const override
+  {
+    return ArithRatPairVec();
+  }
+
+  MipResult solveMIP(bool al) override { return MipUnknown; }
+  Solution extractMIP() const override { return Solution(); }
+
+  void setOptCoeffs(const ArithRatPairVec& ref) override {}
+
+  void tryCut(int nid, CutInfo& cut) override {}
+
+  std::vector<const CutInfo*> getValidCuts(const NodeLog& node) override
+  {
+    return std::vector<const CutInfo*>();
+  }
+
+  ArithVar getBranchVar(const NodeLog& nl) const override
+  {
+    return ARITHVAR_SENTINEL;
+  }
+
+  double sumInfeasibilities(bool mip) const override;
+
+ private:
+  /**
+   * Returns 1 if variable i is above its upper bound, -1 if it is below its
+   * lower bound and 0 otherwise.
+   */
+  int violation(size_t i) const;
+  /** Adds delta to the nonbasic variable j and updates the basic variables. */
+  void update(size_t j, double delta);
+  /** Exchanges the basic variable of row r with the nonbasic variable j. */
+  void pivot(size_t r, size_t j);
+  /** Recomputes the values of the basic variables to limit the drift. */
+  void computeBasicValues();
+
+  /** Maps indices to arith variables. */
+  std::vector<ArithVar> d_toArithVar;
+  /** The bounds of each variable, infinite if there is none. */
+  std::vector<double> d_lb;
+  std::vector<double> d_ub;
+  /** The current value of each variable. */
+  std::vector<double> d_values;
+  /** The basic variable of each row. */
+  std::vector<size_t> d_basicOf;
+  /** Whether a variable is basic. */
+  std::vector<bool> d_isBasic;
+  /** The dense tableau. */
+  std::vector<double> d_tableau;
+  size_t d_numVars;
+  /** Whether the problem fit into the tableau size limit. */
+  bool d_fits;
+  PivotRule d_rule;
+  const std::atomic<bool>* d_stop;
+  int64_t d_pivots;
+
+  /** The maximum number of entries of the dense tableau. */
+  static const size_t s_maxTableauSize;
+  /** Tolerance on the bounds, relative to the bound. */
+  static const double s_feasibilityTol;
+  /** The smallest pivot element and the smallest stored coefficient. */
+  static const double s_pivotTol;
+  static const double s_zeroTol;
+  /**
+   * After this many consecutive degenerate pivots we choose pivots by Bland's
+   * rule to avoid cycling.
+   */
+  static const int s_degenerateLimit;
+  /** How often the basic values are recomputed. */
+  static const int s_refreshInterval;
+};
+
+const size_t ApproxFloat::s_maxTableauSize = 1 << 24;
+const double ApproxFloat::s_feasibilityTol = 1e-9;
+const double ApproxFloat::s_pivotTol = 1e-9;
+const double ApproxFloat::s_zeroTol = 1e-12;
+const int ApproxFloat::s_degenerateLimit = 50;
+const int ApproxFloat::s_refreshInterval = 100;
+
+ApproxFloat::ApproxFloat(const ArithVariables& v,
+                         TreeLog& l,
+                         ApproximateStatistics& s,
+                         PivotRule rule)
+    : ApproximateSimplex(v, l, s),
+      d_numVars(0),
+      d_fits(false),
+      d_rule(rule),
+      d_stop(nullptr),
+      d_pivots(0)
+{
+  DenseMap<size_t> indices;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar av = *vi;
+    indices.set(av, d_toArithVar.size());
+    d_toArithVar.push_back(av);
+    d_isBasic.push_back(d_vars.isAuxiliary(av));
+    if (d_vars.isAuxiliary(av))
+    {
+      d_basicOf.push_back(indices[av]);
+    }
+  }
+  d_numVars = d_toArithVar.size();
+  if (d_basicOf.size() > s_maxTableauSize / std::max<size_t>(d_numVars, 1))
+  {
+    return;
+  }
+  d_fits = true;
+
+  const double inf = std::numeric_limits<double>::infinity();
+  d_lb.resize(d_numVars, -inf);
+  d_ub.resize(d_numVars, inf);
+  d_values.resize(d_numVars, 0.0);
+  for (size_t i = 0; i < d_numVars; ++i)
+  {
+    ArithVar av = d_toArithVar[i];
+    if (d_vars.hasLowerBound(av))
+    {
+      d_lb[i] = d_vars.getLowerBound(av).approx(SMALL_FIXED_DELTA);
+    }
+    if (d_vars.hasUpperBound(av))
+    {
+      d_ub[i] = d_vars.getUpperBound(av).approx(SMALL_FIXED_DELTA);
+    }
+    if (!d_isBasic[i])
+    {
+      double val = d_vars.getAssignment(av).approx(SMALL_FIXED_DELTA);
+      d_values[i] = std::min(std::max(val, d_lb[i]), d_ub[i]);
+    }
+  }
+
+  d_tableau.resize(d_basicOf.size() * d_numVars, 0.0);
+  for (size_t r = 0; r < d_basicOf.size(); ++r)
+  {
+    ArithVar basic = d_toArithVar[d_basicOf[r]];
+    Polynomial p = Polynomial::parsePolynomial(d_vars.asNode(basic));
+    for (Polynomial::iterator i = p.begin(), end = p.end(); i != end; ++i)
+    {
+      const Monomial& mono = *i;
+      Node n = mono.getVarList().getNode();
+      Assert(d_vars.hasArithVar(n));
+      size_t j = indices[d_vars.asArithVar(n)];
+      d_tableau[r * d_numVars + j] = mono.getConstant().getValue().getDouble();
+    }
+  }
+  computeBasicValues();
+}
+
+int ApproxFloat::violation(size_t i) const
+{
+  double val = d_values[i];
+  if (val < d_lb[i] - s_feasibilityTol * (1 + std::abs(d_lb[i])))
+  {
+    return -1;
+  }
+  else if (val > d_ub[i] + s_feasibilityTol * (1 + std::abs(d_ub[i])))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+void ApproxFloat::update(size_t j, double delta)
+{
+  d_values[j] += delta;
+  for (size_t r = 0; r < d_basicOf.size(); ++r)
+  {
+    double a = d_tableau[r * d_numVars + j];
+    if (a != 0.0)
+    {
+      d_values[d_basicOf[r]] += a * delta;
+    }
+  }
+}
+
+void ApproxFloat::pivot(size_t r, size_t j)
+{
+  double* prow = &d_tableau[r * d_numVars];
+  size_t b = d_basicOf[r];
+  double a = prow[j];
+  Assert(std::abs(a) >= s_pivotTol);
+
+  // x_b = a x_j + sum_k c_k x_k  iff  x_j = x_b / a - sum_k (c_k / a) x_k
+  for (size_t k = 0; k < d_numVars; ++k)
+  {
+    prow[k] = -prow[k] / a;
+  }
+  prow[j] = 0.0;
+  prow[b] = 1.0 / a;
+
+  for (size_t s = 0; s < d_basicOf.size(); ++s)
+  {
+    if (s == r)
+    {
+      continue;
+    }
+    double* row = &d_tableau[s * d_numVars];
+    double c = row[j];
+    if (c == 0.0)
+    {
+      continue;
+    }
+    row[j] = 0.0;
+    for (size_t k = 0; k < d_numVars; ++k)
+    {
+      if (prow[k] != 0.0)
+      {
+        double res = row[k] + c * prow[k];
+        row[k] = std::abs(res) < s_zeroTol ? 0.0 : res;
+      }
+    }
+  }
+  d_basicOf[r] = j;
+  d_isBasic[j] = true;
+  d_isBasic[b] = false;
+}
+
+void ApproxFloat::computeBasicValues()
+{
+  for (size_t r = 0; r < d_basicOf.size(); ++r)
+  {
+    const double* row = &d_tableau[r * d_numVars];
+    double sum = 0.0;
+    for (size_t k = 0; k < d_numVars; ++k)
+    {
+      if (row[k] != 0.0)
+      {
+        sum += row[k] * d_values[k];
+      }
+    }
+    d_values[d_basicOf[r]] = sum;
+  }
+}
+
+LinResult ApproxFloat::solveRelaxation()
+{
+  LinResult res = search();
+  d_stats.d_floatPivots += d_pivots;
+  return res;
+}
+
+LinResult ApproxFloat::search()
+{
+  if (!d_fits)
+  {
+    return LinUnknown;
+  }
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> costs(d_numVars);
+  std::vector<double> norms;
+  int degenerate = 0;
+  for (int pivots = 0;; ++pivots)
+  {
+    if (d_stop != nullptr && d_stop->load(std::memory_order_relaxed))
+    {
+      return LinUnknown;
+    }
+    if (pivots % s_refreshInterval == s_refreshInterval - 1)
+    {
+      computeBasicValues();
+    }
+    // the gradient of the sum of infeasibilities w.r.t. the nonbasics
+    std::fill(costs.begin(), costs.end(), 0.0);
+    bool feasible = true;
+    for (size_t r = 0; r < d_basicOf.size(); ++r)
+    {
+      int v = violation(d_basicOf[r]);
+      if (v == 0)
+      {
+        continue;
+      }
+      feasible = false;
+      const double* row = &d_tableau[r * d_numVars];
+      for (size_t k = 0; k < d_numVars; ++k)
+      {
+        costs[k] += v * row[k];
+      }
+    }
+    if (feasible)
+    {
+      return LinFeasible;
+    }
+    if (pivots >= d_pivotLimit)
+    {
+      return LinExhausted;
+    }
+    if (d_rule == PivotRule::STEEPEST_EDGE)
+    {
+      // squared norms of the columns of the nonbasics, counting the nonbasic
+      norms.assign(d_numVars, 1.0);
+      for (size_t r = 0; r < d_basicOf.size(); ++r)
+      {
+        const double* row = &d_tableau[r * d_numVars];
+        for (size_t k = 0; k < d_numVars; ++k)
+        {
+          norms[k] += row[k] * row[k];
+        }
+      }
+    }
+
+    // select the entering variable and its direction
+    bool bland = degenerate >= s_degenerateLimit;
+    size_t entering = d_numVars;
+    int dir = 0;
+    double best = 0.0;
+    for (size_t j = 0; j < d_numVars; ++j)
+    {
+      double c = costs[j];
+      if (d_isBasic[j] || std::abs(c) <= s_pivotTol)
+      {
+        continue;
+      }
+      int d = c < 0 ? 1 : -1;
+      double room = d > 0 ? d_ub[j] - d_values[j] : d_values[j] - d_lb[j];
+      if (room <= s_feasibilityTol * (1 + std::abs(d_values[j])))
+      {
+        continue;
+      }
+      double score = d_rule == PivotRule::STEEPEST_EDGE
+                         ? std::abs(c) / std::sqrt(norms[j])
+                         : std::abs(c);
+      if (score > best)
+      {
+        entering = j;
+        dir = d;
+        best = score;
+        if (bland)
+        {
+          break;
+        }
+      }
+    }
+    if (entering == d_numVars)
+    {
+      // the sum of infeasibilities is minimal and positive
+      return LinInfeasible;
+    }
+
+    // ratio test, entering stops at the first breakpoint
+    double step = dir > 0 ? d_ub[entering] - d_values[entering]
+                          : d_values[entering] - d_lb[entering];
+    size_t leaving = d_basicOf.size();
+    double leavingValue = 0.0;
+    double leavingPivot = 0.0;
+    for (size_t r = 0; r < d_basicOf.size(); ++r)
+    {
+      double a = d_tableau[r * d_numVars + entering] * dir;
+      if (std::abs(a) < s_pivotTol)
+      {
+        continue;
+      }
+      size_t b = d_basicOf[r];
+      int v = violation(b);
+      double bound;
+      if (a > 0)
+      {
+        bound = v < 0 ? d_lb[b] : (v == 0 ? d_ub[b] : inf);
+      }
+      else
+      {
+        bound = v > 0 ? d_ub[b] : (v == 0 ? d_lb[b] : -inf);
+      }
+      if (std::isinf(bound))
+      {
+        continue;
+      }
+      double limit = std::max(0.0, (bound - d_values[b]) / a);
+      if (limit < step
+          || (limit == step && leaving != d_basicOf.size()
+              && (bland ? b < d_basicOf[leaving]
+                        : std::abs(a) > leavingPivot)))
+      {
+        step = limit;
+        leaving = r;
+        leavingValue = bound;
+        leavingPivot = std::abs(a);
+      }
+    }
+    if (std::isinf(step))
+    {
+      return LinUnknown;
+    }
+
+    update(entering, dir * step);
+    degenerate = step == 0.0 ? degenerate + 1 : 0;
+    if (leaving == d_basicOf.size())
+    {
+      // bound flip of the entering variable
+      d_values[entering] = dir > 0 ? d_ub[entering] : d_lb[entering];
+    }
+    else
+    {
+      d_values[d_basicOf[leaving]] = leavingValue;
+      pivot(leaving, entering);
+      ++d_pivots;
+    }
+  }
+}
+
+ApproximateSimplex::Solution ApproxFloat::extractRelaxation() const
+{
+  Solution sol;
+  if (!d_fits)
+  {
+    return sol;
+  }
+  for (size_t i = 0; i < d_numVars; ++i)
+  {
+    ArithVar v = d_toArithVar[i];
+    if (d_isBasic[i])
+    {
+      sol.newBasis.add(v);
+    }
+    sol.newValues.set(v, estimateAssignment(v, d_values[i]));
+  }
+  return sol;
+}
+
+double ApproxFloat::sumInfeasibilities(bool mip) const
+{
+  double infeas = 0.0;
+  for (size_t i = 0; i < d_values.size(); ++i)
+  {
+    infeas += std::max(0.0, d_lb[i] - d_values[i]);
+    infeas += std::max(0.0, d_values[i] - d_ub[i]);
+  }
+  return infeas;
+}
+
+/**
+ * Races two copies of ApproxFloat using different pivot rules. The second
+ * copy runs on its own thread, and the first copy to reach a feasible basis
+ * or to prove infeasibility stops the other one and is adopted.
+ */
+class ApproxFloatRace : public ApproximateSimplex
+{
+ public:
+  ApproxFloatRace(const ArithVariables& v,
+                  TreeLog& l,
+                  ApproximateStatistics& s);
+  ~ApproxFloatRace() {}
+
+  LinResult solveRelaxation() override;
+  Solution extractRelaxation() const override
+  {
+    return d_winner->extractRelaxation();
+  }
+
+  ArithRatPairVec heuristicOptCoeffs() const override
+  {
+    return ArithRatPairVec();
+  }
+
+  MipResult solveMIP(bool al) override { return MipUnknown; }
+  Solution extractMIP() const override { return Solution(); }
+
+  void setOptCoeffs(const ArithRatPairVec& ref) override {}
+
+  void tryCut(int nid, CutInfo& cut) override {}
+
+  std::vector<const CutInfo*> getValidCuts(const NodeLog& node) override
+  {
+    return std::vector<const CutInfo*>();
+  }
+
+  ArithVar getBranchVar(const NodeLog& nl) const override
+  {
+    return ARITHVAR_SENTINEL;
+  }
+
+  double sumInfeasibilities(bool mip) const override
+  {
+    return d_winner->sumInfeasibilities(mip);
+  }
+
+ private:
+  ApproxFloat d_dantzig;
+  ApproxFloat d_steepest;
+  /** The copy whose result is reported. */
+  ApproxFloat* d_winner;
+};
+
+ApproxFloatRace::ApproxFloatRace(const ArithVariables& v,
+                                 TreeLog& l,
+                                 ApproximateStatistics& s)
+    : ApproximateSimplex(v, l, s),
+      d_dantzig(v, l, s, ApproxFloat::PivotRule::LARGEST_COEFFICIENT),
+      d_steepest(v, l, s, ApproxFloat::PivotRule::STEEPEST_EDGE),
+      d_winner(&d_dantzig)
+{
+}
+
+LinResult ApproxFloatRace::solveRelaxation()
+{
+  std::atomic<bool> stop(false);
+  std::atomic<ApproxFloat*> winner(nullptr);
+  auto run = [&stop, &winner](ApproxFloat* af) {
+    LinResult res = af->search();
+    if (res == LinFeasible || res == LinInfeasible)
+    {
+      ApproxFloat* none = nullptr;
+      winner.compare_exchange_strong(none, af);
+      stop.store(true, std::memory_order_relaxed);
+    }
+    return res;
+  };
+
+  d_dantzig.setPivotLimit(d_pivotLimit);
+  d_steepest.setPivotLimit(d_pivotLimit);
+  d_dantzig.setStopFlag(&stop);
+  d_steepest.setStopFlag(&stop);
+
+  LinResult steepestRes = LinUnknown;
+  std::thread t([&]() { steepestRes = run(&d_steepest); });
+  LinResult dantzigRes = run(&d_dantzig);
+  t.join();
+
+  d_dantzig.setStopFlag(nullptr);
+  d_steepest.setStopFlag(nullptr);
+  ++d_stats.d_floatRaces;
+  d_stats.d_floatPivots += d_dantzig.getPivots() + d_steepest.getPivots();
+
+  if (winner.load() != nullptr)
+  {
+    d_winner = winner.load();
+    if (d_winner == &d_steepest)
+    {
+      ++d_stats.d_floatRaceSteepestWins;
+    }
+  }
+  return d_winner == &d_steepest ? steepestRes : dantzigRes;
+}
+
 }/* CVC4::theory::arith namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
@@ -547,6 +1184,16 @@ ApproximateSimplex* ApproximateSimplex::mkApproximateSimplexSolver(const ArithVa
   return new ApproxNoOp(vars, l, s);
 #endif
 }
+ApproximateSimplex* ApproximateSimplex::mkFloatSimplexSolver(
+    const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s)
+{
+  return new ApproxFloat(vars, l, s);
+}
+ApproximateSimplex* ApproximateSimplex::mkFloatSimplexRace(
+    const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s)
+{
+  return new ApproxFloatRace(vars, l, s);
+}
 bool ApproximateSimplex::enabled() {
 #ifdef CVC4_USE_GLPK
   return true;
@@ -1072,76 +1719,7 @@ ApproximateSimplex::Solution ApproxGLPK::extractSolution(bool mip) const
         newAssign = (isAux ? glp_get_row_prim(prob, glpk_index)
                      :  glp_get_col_prim(prob, glpk_index));
       }
-      const DeltaRational& oldAssign = d_vars.getAssignment(vi);
-
-      if (d_vars.hasLowerBound(vi)
-          && roughlyEqual(newAssign,
-                          d_vars.getLowerBound(vi).approx(SMALL_FIXED_DELTA)))
-      {
-        // CVC4Message() << "  to lb" << endl;
-
-        newValues.set(vi, d_vars.getLowerBound(vi));
-      }
-      else if (d_vars.hasUpperBound(vi)
-               && roughlyEqual(
-                   newAssign,
-                   d_vars.getUpperBound(vi).approx(SMALL_FIXED_DELTA)))
-      {
-        newValues.set(vi, d_vars.getUpperBound(vi));
-        // CVC4Message() << "  to ub" << endl;
-      }
-      else
-      {
-        double rounded = round(newAssign);
-        if (roughlyEqual(newAssign, rounded))
-        {
-          // CVC4Message() << "roughly equal " << rounded << " " << newAssign <<
-          // " " << oldAssign << endl;
-          newAssign = rounded;
-        }
-        else
-        {
-          // CVC4Message() << "not roughly equal " << rounded << " " <<
-          // newAssign << " " << oldAssign << endl;
-        }
-
-        DeltaRational proposal;
-        if (Maybe<Rational> maybe_new = estimateWithCFE(newAssign))
-        {
-          proposal = maybe_new.value();
-        }
-        else
-        {
-          // failed to estimate the old value. defaulting to the current.
-          proposal = d_vars.getAssignment(vi);
-        }
-
-        if (roughlyEqual(newAssign, oldAssign.approx(SMALL_FIXED_DELTA)))
-        {
-          // CVC4Message() << "  to prev value" << newAssign << " " << oldAssign
-          // << endl;
-          proposal = d_vars.getAssignment(vi);
-        }
-
-        if (d_vars.strictlyLessThanLowerBound(vi, proposal))
-        {
-          // CVC4Message() << "  round to lb " << d_vars.getLowerBound(vi) <<
-          // endl;
-          proposal = d_vars.getLowerBound(vi);
-        }
-        else if (d_vars.strictlyGreaterThanUpperBound(vi, proposal))
-        {
-          // CVC4Message() << "  round to ub " << d_vars.getUpperBound(vi) <<
-          // endl;
-          proposal = d_vars.getUpperBound(vi);
-        }
-        else
-        {
-          // CVC4Message() << "  use proposal" << proposal << " " << oldAssign
-          // << endl;
-        }
-        newValues.set(vi, proposal);
-      }
+      newValues.set(vi, estimateAssignment(vi, newAssign));
     }
   }
   return sol;
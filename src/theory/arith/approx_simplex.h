@@ -60,6 +60,13 @@ class ApproximateStatistics {
   TimerStat d_gaussianElimConstructTime;
   IntStat d_gaussianElimConstruct;
   AverageStat d_averageGuesses;
+
+  /** Number of pivots done by the built-in floating point simplex. */
+  IntStat d_floatPivots;
+  /** Number of races run by mkFloatSimplexRace. */
+  IntStat d_floatRaces;
+  /** Number of races won by the steepest edge rule (see mkFloatSimplexRace). */
+  IntStat d_floatRaceSteepestWins;
 };
 
 
@@ -78,6 +85,22 @@ class ApproximateSimplex{
    * If glpk is disabled, return a subclass that does nothing.
    */
   static ApproximateSimplex* mkApproximateSimplexSolver(const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s);
+
+  /**
+   * Returns the built-in double precision simplex solver. This does not
+   * depend on glpk, but only supports solveRelaxation() and
+   * extractRelaxation().
+   */
+  static ApproximateSimplex* mkFloatSimplexSolver(const ArithVariables& vars,
+                                                  TreeLog& l,
+                                                  ApproximateStatistics& s);
+  /**
+   * Like mkFloatSimplexSolver(), but solveRelaxation() races two pivot rules
+   * on separate copies of the tableau, each on its own thread.
+   */
+  static ApproximateSimplex* mkFloatSimplexRace(const ArithVariables& vars,
+                                                TreeLog& l,
+                                                ApproximateStatistics& s);
   ApproximateSimplex(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s);
   virtual ~ApproximateSimplex(){}
 
@@ -147,6 +170,14 @@ class ApproximateSimplex{
   virtual double sumInfeasibilities(bool mip) const = 0;
 
  protected:
+  /**
+   * Estimates a rational value for v from the approximate value newAssign.
+   * This snaps to the bounds of v and to its current assignment if these are
+   * close, and otherwise uses a continued fraction expansion that is clamped
+   * to the bounds of v.
+   */
+  DeltaRational estimateAssignment(ArithVar v, double newAssign) const;
+
   const ArithVariables& d_vars;
   TreeLog& d_log;
   ApproximateStatistics& d_stats;
@@ -18,6 +18,8 @@
 #include "cvc4_private.h"
 #pragma once
 
+#include <utility>
+
 #include "base/check.h"
 #include "theory/arith/arithvar.h"
 #include "util/dense_map.h"
@@ -214,6 +216,69 @@ public:
 /** This is intended to map each row to its relevant bound information. */
 typedef DenseMap<BoundsInfo> BoundInfoMap;
 
+/**
+ * Watches the variables on a row that lack the bound counted by the
+ * row's hasBounds() in each direction.  A watch is the exclusive-or of the
+ * variables lacking the bound, so when exactly one variable lacks it
+ * (the count is one less than the row length) the watch is that variable.
+ * This finds the single unbounded variable in O(1) instead of scanning
+ * the row.
+ */
+class BoundWatches {
+private:
+  ArithVar d_lacksLower;
+  ArithVar d_lacksUpper;
+
+public:
+  BoundWatches() : d_lacksLower(0), d_lacksUpper(0) {}
+
+  bool operator==(const BoundWatches& other) const{
+    return d_lacksLower == other.d_lacksLower
+      && d_lacksUpper == other.d_lacksUpper;
+  }
+  bool operator!=(const BoundWatches& other) const{
+    return !(*this == other);
+  }
+
+  /** Only meaningful if exactly one variable lacks the bound. */
+  inline ArithVar lacksLowerBound() const { return d_lacksLower; }
+  inline ArithVar lacksUpperBound() const { return d_lacksUpper; }
+
+  /**
+   * Adds (or removes) the variable v whose coefficient has sign sgn and
+   * whose has bound counts are hasBounds.
+   */
+  inline void toggle(ArithVar v, int sgn, BoundCounts hasBounds){
+    if(sgn == 0){ return; }
+    BoundCounts bc = hasBounds.multiplyBySgn(sgn);
+    if(bc.lowerBoundCount() == 0){ d_lacksLower ^= v; }
+    if(bc.upperBoundCount() == 0){ d_lacksUpper ^= v; }
+  }
+
+  /** See BoundCounts::addInChange(). */
+  inline void addInChange(ArithVar v, int sgn, BoundCounts before, BoundCounts after){
+    if(before != after){
+      toggle(v, sgn, before);
+      toggle(v, sgn, after);
+    }
+  }
+
+  /** See BoundCounts::addInSgn(). */
+  inline void addInSgn(ArithVar v, BoundCounts hasBounds, int before, int after){
+    toggle(v, before, hasBounds);
+    toggle(v, after, hasBounds);
+  }
+
+  /** See BoundCounts::multiplyBySgn(). */
+  inline void multiplyBySgn(int sgn){
+    if(sgn < 0){
+      std::swap(d_lacksLower, d_lacksUpper);
+    }
+  }
+};
+
+typedef DenseMap<BoundWatches> BoundWatchMap;
+
 inline std::ostream& operator<<(std::ostream& os, const BoundCounts& bc){
   os << "[bc " << bc.lowerBoundCount() << ", " << bc.upperBoundCount() << "]";
   return os;
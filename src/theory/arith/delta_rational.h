@@ -54,6 +54,8 @@ public:
   DeltaRational(const CVC4::Rational& base) : c(base), k(0,1) {}
   DeltaRational(const CVC4::Rational& base, const CVC4::Rational& coeff) :
     c(base), k(coeff) {}
+  DeltaRational(const DeltaRational& other) = default;
+  DeltaRational(DeltaRational&& other) = default;
 
   const CVC4::Rational& getInfinitesimalPart() const {
     return k;
@@ -129,8 +131,9 @@ public:
 
 
   DeltaRational operator-(const DeltaRational& a) const{
-    CVC4::Rational negOne(CVC4::Integer(-1));
-    return *(this) + (a * negOne);
+    CVC4::Rational tmpC = c-a.c;
+    CVC4::Rational tmpK = k-a.k;
+    return DeltaRational(tmpC, tmpK);
   }
 
   DeltaRational operator-() const{
@@ -168,7 +171,7 @@ public:
     if(sgn() >= 0){
       return *this;
     }else{
-      return (*this) * Rational(-1);
+      return -(*this);
     }
   }
 
@@ -206,6 +209,8 @@ public:
     return *(this);
   }
 
+  DeltaRational& operator=(DeltaRational&& other) = default;
+
   DeltaRational& operator*=(const CVC4::Rational& a){
     c *=  a;
     k *=  a;
@@ -16,6 +16,7 @@
 #include "theory/arith/linear_equality.h"
 
 #include "base/output.h"
+#include "options/arith_options.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/arith/constraint.h"
 
@@ -62,12 +63,14 @@ LinearEqualityModule::LinearEqualityModule(ArithVariables& vars, Tableau& t, Bou
   d_one(1),
   d_negOne(-1),
   d_btracking(boundsTracking),
+  d_bwatches(),
   d_areTracking(false),
   d_trackCallback(this)
 {}
 
 LinearEqualityModule::Statistics::Statistics():
   d_statPivots("theory::arith::pivots",0),
+  d_statCompactions("theory::arith::compactions",0),
   d_statUpdates("theory::arith::updates",0),
   d_pivotTime("theory::arith::pivotTime"),
   d_adjTime("theory::arith::adjTime"),
@@ -78,6 +81,7 @@ LinearEqualityModule::Statistics::Statistics():
   d_forceTime("theory::arith::forcing::time")
 {
   smtStatisticsRegistry()->registerStat(&d_statPivots);
+  smtStatisticsRegistry()->registerStat(&d_statCompactions);
   smtStatisticsRegistry()->registerStat(&d_statUpdates);
 
   smtStatisticsRegistry()->registerStat(&d_pivotTime);
@@ -92,6 +96,7 @@ LinearEqualityModule::Statistics::Statistics():
 
 LinearEqualityModule::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_statPivots);
+  smtStatisticsRegistry()->unregisterStat(&d_statCompactions);
   smtStatisticsRegistry()->unregisterStat(&d_statUpdates);
   smtStatisticsRegistry()->unregisterStat(&d_pivotTime);
   smtStatisticsRegistry()->unregisterStat(&d_adjTime);
@@ -120,6 +125,8 @@ void LinearEqualityModule::includeBoundUpdate(ArithVar v, const BoundsInfo& prev
     BoundsInfo& counts = d_btracking.get(ridx);
     Debug("includeBoundUpdate") << d_tableau.rowIndexToBasic(ridx) << " " << counts << " to " ;
     counts.addInChange(a_ijSgn, prev, curr);
+    d_bwatches.get(ridx).addInChange(
+        v, a_ijSgn, prev.hasBounds(), curr.hasBounds());
     Debug("includeBoundUpdate") << counts << " " << a_ijSgn << std::endl;
   }
 }
@@ -309,6 +316,11 @@ void LinearEqualityModule::pivotAndUpdate(ArithVar x_i, ArithVar x_j, const Delt
   // Pivots
   ++(d_statistics.d_statPivots);
 
+  if(options::arithCompactTableau() && d_tableau.shouldCompact()){
+    ++(d_statistics.d_statCompactions);
+    d_tableau.compact();
+  }
+
   d_tableau.pivot(x_i, x_j, d_trackCallback);
 
   if(Debug.isOn("arith::tracking::post")){
@@ -365,6 +377,7 @@ void LinearEqualityModule::debugCheckTracking(){
         << "computed " << computed
         << " tracking " << d_btracking[ridx] << endl;
       Assert(computed == d_btracking[ridx]);
+      Assert(computeRowBoundWatches(ridx, false) == d_bwatches[ridx]);
     }
   }
 }
@@ -879,6 +892,7 @@ void LinearEqualityModule::trackRowIndex(RowIndex ridx){
   Assert(!rowIndexIsTracked(ridx));
   BoundsInfo bi = computeRowBoundInfo(ridx, true);
   d_btracking.set(ridx, bi);
+  d_bwatches.set(ridx, computeRowBoundWatches(ridx, true));
 }
 
 BoundsInfo LinearEqualityModule::computeRowBoundInfo(RowIndex ridx, bool inQueue) const{
@@ -894,6 +908,35 @@ BoundsInfo LinearEqualityModule::computeRowBoundInfo(RowIndex ridx, bool inQueue
   return bi;
 }
 
+BoundWatches LinearEqualityModule::computeRowBoundWatches(RowIndex ridx,
+                                                          bool inQueue) const
+{
+  BoundWatches bw;
+
+  Tableau::RowIterator iter = d_tableau.ridRowIterator(ridx);
+  for(; !iter.atEnd();  ++iter){
+    const Tableau::Entry& entry = *iter;
+    ArithVar v = entry.getColVar();
+    const Rational& a_ij = entry.getCoefficient();
+    bw.toggle(v,
+              a_ij.sgn(),
+              d_variables.selectBoundsInfo(v, inQueue).hasBounds());
+  }
+  return bw;
+}
+
+const Tableau::Entry& LinearEqualityModule::watchedLacksBound(RowIndex ri,
+                                                              bool rowUb) const
+{
+  Assert(d_variables.boundsQueueEmpty());
+  Assert(rowIndexIsTracked(ri));
+  const BoundWatches& bw = d_bwatches[ri];
+  ArithVar v = rowUb ? bw.lacksUpperBound() : bw.lacksLowerBound();
+  const Tableau::Entry& entry = d_tableau.findEntry(ri, v);
+  Assert(!entry.blank());
+  return entry;
+}
+
 BoundCounts LinearEqualityModule::debugBasicAtBoundCount(ArithVar x_i) const {
   return d_btracking[d_tableau.basicToRowIndex(x_i)].atBounds();
 }
@@ -980,6 +1023,7 @@ void LinearEqualityModule::trackingMultiplyRow(RowIndex ridx, int sgn) {
   if(sgn < 0){
     BoundsInfo& bi = d_btracking.get(ridx);
     bi = bi.multiplyBySgn(sgn);
+    d_bwatches.get(ridx).multiplyBySgn(sgn);
   }
 }
 
@@ -991,6 +1035,7 @@ void LinearEqualityModule::trackingCoefficientChange(RowIndex ridx, ArithVar nb,
 
   BoundsInfo& row_bi = d_btracking.get(ridx);
   row_bi.addInSgn(nb_inf, oldSgn, currSgn);
+  d_bwatches.get(ridx).addInSgn(nb, nb_inf.hasBounds(), oldSgn, currSgn);
 }
 
 ArithVar LinearEqualityModule::minBy(const ArithVarVec& vec, VarPreferenceFunction pf) const{
@@ -410,6 +410,11 @@ private:
    * and how many are assigned at their bounds.
    */
   BoundInfoMap& d_btracking;
+  /**
+   * For each tracked row, the variables lacking a bound (see BoundWatches).
+   * This is kept in sync with the has bound counts in d_btracking.
+   */
+  BoundWatchMap d_bwatches;
   bool d_areTracking;
 
 public:
@@ -533,6 +538,7 @@ public:
   void stopTrackingRowIndex(RowIndex ridx){
     Assert(rowIndexIsTracked(ridx));
     d_btracking.remove(ridx);
+    d_bwatches.remove(ridx);
   }
 
   /**
@@ -552,6 +558,9 @@ private:
    */
   BoundsInfo computeRowBoundInfo(RowIndex ridx, bool inQueue) const;
 
+  /** Recomputes the bound watches for a row. O(row length of ridx) */
+  BoundWatches computeRowBoundWatches(RowIndex ridx, bool inQueue) const;
+
 public:
   /** Debug only routine. */
   BoundCounts debugBasicAtBoundCount(ArithVar x_i) const;
@@ -568,6 +577,15 @@ public:
     return d_btracking[ri].hasBounds();
   }
 
+  /**
+   * Returns the entry of the only variable on the row lacking an upper/lower
+   * bound (mod sgns), i.e. the one rowLacksBound() would find.
+   * Precondition: hasBoundCount(ri) is one less than the row length in the
+   * direction rowUb.
+   * O(min(row length, column length)) instead of a scan of the row.
+   */
+  const Tableau::Entry& watchedLacksBound(RowIndex ri, bool rowUb) const;
+
   /**
    * Are there any non-basics on x_i's row that are not at
    * their respective lower bounds (mod sgns).
@@ -704,6 +722,7 @@ private:
   class Statistics {
   public:
     IntStat d_statPivots, d_statUpdates;
+    IntStat d_statCompactions;
     TimerStat d_pivotTime;
     TimerStat d_adjTime;
 
@@ -207,6 +207,23 @@ public:
   uint32_t size() const{ return d_size; }
   uint32_t capacity() const{ return d_entries.capacity(); }
 
+  /**
+   * Keeps only the entries in ids, moving ids[i] to the new id i.
+   * The caller is responsible for updating the ids stored in the entries.
+   */
+  void reorder(const std::vector<EntryID>& ids){
+    EntryArray entries;
+    entries.reserve(ids.size());
+    for(EntryID id : ids){
+      Assert(inBounds(id));
+      Assert(!d_entries[id].blank());
+      entries.push_back(std::move(d_entries[id]));
+    }
+    d_entries.swap(entries);
+    d_freedEntries = std::queue<EntryID>();
+    d_size = ids.size();
+  }
+
 
 private:
   bool inBounds(EntryID id) const{
@@ -395,6 +412,9 @@ protected:
   uint32_t d_entriesInUse;
   MatrixEntryVector<T> d_entries;
 
+  /* The number of entries added since the last call to compact(). */
+  uint32_t d_entriesAddedSinceCompact;
+
   std::vector<RowIndex> d_pool;
 
   T d_zero;
@@ -410,6 +430,7 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesAddedSinceCompact(0),
     d_zero(0)
   {}
 
@@ -420,6 +441,7 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesAddedSinceCompact(0),
     d_zero(zero)
   {}
 
@@ -430,6 +452,7 @@ public:
     d_rowInMergeBuffer(m.d_rowInMergeBuffer),
     d_entriesInUse(m.d_entriesInUse),
     d_entries(m.d_entries),
+    d_entriesAddedSinceCompact(m.d_entriesAddedSinceCompact),
     d_zero(m.d_zero)
   {
     d_columns.clear();
@@ -449,6 +472,7 @@ public:
     d_rowInMergeBuffer = (m.d_rowInMergeBuffer);
     d_entriesInUse = (m.d_entriesInUse);
     d_entries = (m.d_entries);
+    d_entriesAddedSinceCompact = (m.d_entriesAddedSinceCompact);
     d_zero = (m.d_zero);
     d_columns.clear();
     for(typename ColumnTable::const_iterator c=m.d_columns.begin(), cend = m.d_columns.end(); c!=cend; ++c){
@@ -479,6 +503,7 @@ protected:
     Assert(newEntry.getCoefficient() != 0);
 
     ++d_entriesInUse;
+    ++d_entriesAddedSinceCompact;
 
     d_rows[row].insert(newId);
     d_columns[col].insert(newId);
@@ -892,6 +917,61 @@ public:
     }
   }
 
+  /**
+   * Returns true if enough entries have been added since the last
+   * compaction that the rows are likely to be scattered over d_entries.
+   */
+  bool shouldCompact() const {
+    static const uint32_t minimumEntries = 1024;
+    return d_entriesAddedSinceCompact >= minimumEntries
+           && d_entriesAddedSinceCompact >= d_entriesInUse;
+  }
+
+  /**
+   * Renumbers the entries so that the entries of each row are stored
+   * contiguously, rows in order of their index. The order of the entries
+   * within each row and column is unchanged, so this is not observable
+   * through the iterators, but it makes row traversals cache friendly after
+   * many pivots have interleaved the rows.
+   *
+   * This invalidates all EntryIDs and iterators, and may not be called
+   * while a row is loaded into the merge buffer.
+   */
+  void compact(){
+    Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
+    Assert(d_mergeBuffer.empty());
+
+    std::vector<EntryID> order;
+    order.reserve(d_entriesInUse);
+    std::vector<EntryID> remap(d_entries.capacity(), ENTRYID_SENTINEL);
+    for(RowIndex rid = 0, N = d_rows.size(); rid < N; ++rid){
+      for(RowIterator i = getRow(rid).begin(); !i.atEnd(); ++i){
+        remap[i.getID()] = order.size();
+        order.push_back(i.getID());
+      }
+    }
+    Assert(order.size() == d_entriesInUse);
+    d_entries.reorder(order);
+
+    auto newId = [&remap](EntryID id) {
+      return id == ENTRYID_SENTINEL ? ENTRYID_SENTINEL : remap[id];
+    };
+    for(EntryID id = 0, N = order.size(); id < N; ++id){
+      Entry& entry = d_entries.get(id);
+      entry.setNextRowEntryID(newId(entry.getNextRowEntryID()));
+      entry.setPrevRowEntryID(newId(entry.getPrevRowEntryID()));
+      entry.setNextColEntryID(newId(entry.getNextColEntryID()));
+      entry.setPrevColEntryID(newId(entry.getPrevColEntryID()));
+    }
+    for(RowVectorT& row : d_rows){
+      row = RowVectorT(newId(row.getHead()), row.getSize(), &d_entries);
+    }
+    for(ColumnVectorT& col : d_columns){
+      col = ColumnVectorT(newId(col.getHead()), col.getSize(), &d_entries);
+    }
+    d_entriesAddedSinceCompact = 0;
+  }
+
   void removeRow(RowIndex rid){
     RowIterator i = getRow(rid).begin();
     RowIterator i_end = getRow(rid).end();
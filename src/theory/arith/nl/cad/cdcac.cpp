@@ -19,7 +19,11 @@
 
 #ifdef CVC4_POLY_IMP
 
+#include <algorithm>
+#include <utility>
+
 #include "options/arith_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/arith/nl/cad/projections.h"
 #include "theory/arith/nl/cad/variable_ordering.h"
 #include "theory/arith/nl/nl_model.h"
@@ -40,6 +44,8 @@ namespace arith {
 namespace nl {
 namespace cad {
 
+const std::size_t CDCAC::s_maxCacheSize = 1 << 16;
+
 CDCAC::CDCAC(context::Context* ctx,
              ProofNodeManager* pnm,
              const std::vector<poly::Variable>& ordering)
@@ -60,8 +66,14 @@ void CDCAC::reset()
 void CDCAC::computeVariableOrdering()
 {
   // Actually compute the variable ordering
-  d_variableOrdering = d_varOrder(d_constraints.getConstraints(),
-                                  VariableOrderingStrategy::BROWN);
+  std::vector<poly::Variable> ordering = d_varOrder(
+      d_constraints.getConstraints(), VariableOrderingStrategy::BROWN);
+  if (ordering != d_variableOrdering)
+  {
+    // cached polynomials are only meaningful for the old ordering
+    clearCaches();
+  }
+  d_variableOrdering = ordering;
   Trace("cdcac") << "Variable ordering is now " << d_variableOrdering
                  << std::endl;
 
@@ -115,7 +127,7 @@ std::vector<CACInterval> CDCAC::getUnsatIntervals(std::size_t cur_variable)
 
     Trace("cdcac") << "Infeasible intervals for " << p << " " << sc
                    << " 0 over " << d_assignment << std::endl;
-    auto intervals = infeasible_regions(p, d_assignment, sc);
+    auto intervals = infeasibleRegions(p, sc, n);
     for (const auto& i : intervals)
     {
       Trace("cdcac") << "-> " << i << std::endl;
@@ -208,7 +220,7 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
       Trace("cdcac") << "Discriminant of " << p << " -> " << discriminant(p)
                      << std::endl;
       // Add all discriminants
-      res.add(discriminant(p));
+      res.add(cachedDiscriminant(p));
 
       for (const auto& q : requiredCoefficients(p))
       {
@@ -221,18 +233,20 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
         if (p == q) continue;
         // Check whether p(s \times a) = 0 for some a <= l
         if (!hasRootBelow(q, get_lower(i.d_interval))) continue;
-        Trace("cdcac") << "Resultant of " << p << " and " << q << " -> "
-                       << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+        poly::Polynomial r = cachedResultant(p, q);
+        Trace("cdcac") << "Resultant of " << p << " and " << q << " -> " << r
+                       << std::endl;
+        res.add(r);
       }
       for (const auto& q : i.d_upperPolys)
       {
         if (p == q) continue;
         // Check whether p(s \times a) = 0 for some a >= u
         if (!hasRootAbove(q, get_upper(i.d_interval))) continue;
-        Trace("cdcac") << "Resultant of " << p << " and " << q << " -> "
-                       << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+        poly::Polynomial r = cachedResultant(p, q);
+        Trace("cdcac") << "Resultant of " << p << " and " << q << " -> " << r
+                       << std::endl;
+        res.add(r);
       }
     }
   }
@@ -244,9 +258,10 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
     {
       for (const auto& q : intervals[i + 1].d_lowerPolys)
       {
-        Trace("cdcac") << "Resultant of " << p << " and " << q << " -> "
-                       << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+        poly::Polynomial r = cachedResultant(p, q);
+        Trace("cdcac") << "Resultant of " << p << " and " << q << " -> " << r
+                       << std::endl;
+        res.add(r);
       }
     }
   }
@@ -280,7 +295,7 @@ CACInterval CDCAC::intervalFromCharacterization(
   roots.emplace_back(poly::Value::minus_infty());
   for (const auto& p : m)
   {
-    auto tmp = isolate_real_roots(p, d_assignment);
+    auto tmp = isolateRealRoots(p);
     roots.insert(roots.end(), tmp.begin(), tmp.end());
   }
   roots.emplace_back(poly::Value::plus_infty());
@@ -357,6 +372,27 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
   }
   Trace("cdcac") << "Looking for unsat cover for "
                  << d_variableOrdering[curVariable] << std::endl;
+  // Coverings are only reused without proofs, as the proof of a covering is
+  // built while computing it.
+  bool useCoverCache = options::nlCadCache() && !isProofEnabled();
+  if (useCoverCache && curVariable == 0)
+  {
+    syncCoverCache();
+  }
+  AssignmentPrefix prefix;
+  if (useCoverCache)
+  {
+    prefix = assignmentPrefix();
+    // A cached covering is complete, whereas the caller asks to stop at the
+    // first interval found by recursion, hence we compute it instead.
+    auto it = returnFirstInterval ? d_covers.end() : d_covers.find(prefix);
+    if (it != d_covers.end())
+    {
+      Trace("cdcac") << "Reusing covering for " << d_assignment << std::endl;
+      ++d_statistics.d_coverHits;
+      return it->second;
+    }
+  }
   std::vector<CACInterval> intervals = getUnsatIntervals(curVariable);
 
   if (Trace.isOn("cdcac"))
@@ -459,6 +495,14 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
   {
     d_proof->endRecursive();
   }
+  if (useCoverCache)
+  {
+    if (d_covers.size() >= s_maxCacheSize)
+    {
+      d_covers.clear();
+    }
+    d_covers.emplace(prefix, intervals);
+  }
   return intervals;
 }
 
@@ -506,24 +550,178 @@ CACInterval CDCAC::buildIntegralityInterval(std::size_t cur_variable,
                      {}};
 }
 
-bool CDCAC::hasRootAbove(const poly::Polynomial& p,
-                         const poly::Value& val) const
+bool CDCAC::hasRootAbove(const poly::Polynomial& p, const poly::Value& val)
 {
-  auto roots = poly::isolate_real_roots(p, d_assignment);
+  auto roots = isolateRealRoots(p);
   return std::any_of(roots.begin(), roots.end(), [&val](const poly::Value& r) {
     return r >= val;
   });
 }
 
-bool CDCAC::hasRootBelow(const poly::Polynomial& p,
-                         const poly::Value& val) const
+bool CDCAC::hasRootBelow(const poly::Polynomial& p, const poly::Value& val)
 {
-  auto roots = poly::isolate_real_roots(p, d_assignment);
+  auto roots = isolateRealRoots(p);
   return std::any_of(roots.begin(), roots.end(), [&val](const poly::Value& r) {
     return r <= val;
   });
 }
 
+CDCAC::AssignmentPrefix CDCAC::assignmentPrefix() const
+{
+  AssignmentPrefix res;
+  for (const auto& v : d_variableOrdering)
+  {
+    if (!d_assignment.has(v)) break;
+    res.emplace_back(d_assignment.get(v));
+  }
+  return res;
+}
+
+std::vector<poly::Value> CDCAC::isolateRealRoots(const poly::Polynomial& p)
+{
+  if (!options::nlCadCache())
+  {
+    return poly::isolate_real_roots(p, d_assignment);
+  }
+  auto key = std::make_pair(p, assignmentPrefix());
+  auto it = d_roots.find(key);
+  if (it == d_roots.end())
+  {
+    if (d_roots.size() >= s_maxCacheSize)
+    {
+      d_roots.clear();
+    }
+    it = d_roots.emplace(key, poly::isolate_real_roots(p, d_assignment)).first;
+  }
+  else
+  {
+    ++d_statistics.d_rootHits;
+  }
+  return it->second;
+}
+
+std::vector<poly::Interval> CDCAC::infeasibleRegions(const poly::Polynomial& p,
+                                                     poly::SignCondition sc,
+                                                     const Node& n)
+{
+  if (!options::nlCadCache())
+  {
+    return infeasible_regions(p, d_assignment, sc);
+  }
+  // the constraint n determines both p and sc
+  auto key = std::make_pair(n, assignmentPrefix());
+  auto it = d_infeasibleRegions.find(key);
+  if (it == d_infeasibleRegions.end())
+  {
+    if (d_infeasibleRegions.size() >= s_maxCacheSize)
+    {
+      d_infeasibleRegions.clear();
+    }
+    it = d_infeasibleRegions
+             .emplace(key, infeasible_regions(p, d_assignment, sc))
+             .first;
+  }
+  else
+  {
+    ++d_statistics.d_intervalHits;
+  }
+  return it->second;
+}
+
+poly::Polynomial CDCAC::cachedDiscriminant(const poly::Polynomial& p)
+{
+  if (!options::nlCadCache())
+  {
+    return discriminant(p);
+  }
+  auto it = d_discriminants.find(p);
+  if (it == d_discriminants.end())
+  {
+    if (d_discriminants.size() >= s_maxCacheSize)
+    {
+      d_discriminants.clear();
+    }
+    it = d_discriminants.emplace(p, discriminant(p)).first;
+  }
+  else
+  {
+    ++d_statistics.d_discriminantHits;
+  }
+  return it->second;
+}
+
+poly::Polynomial CDCAC::cachedResultant(const poly::Polynomial& p,
+                                        const poly::Polynomial& q)
+{
+  if (!options::nlCadCache())
+  {
+    return resultant(p, q);
+  }
+  auto key = std::make_pair(p, q);
+  auto it = d_resultants.find(key);
+  if (it == d_resultants.end())
+  {
+    if (d_resultants.size() >= s_maxCacheSize)
+    {
+      d_resultants.clear();
+    }
+    it = d_resultants.emplace(key, resultant(p, q)).first;
+  }
+  else
+  {
+    ++d_statistics.d_resultantHits;
+  }
+  return it->second;
+}
+
+void CDCAC::syncCoverCache()
+{
+  std::vector<Node> constraints;
+  for (const auto& c : d_constraints.getConstraints())
+  {
+    constraints.emplace_back(std::get<2>(c));
+  }
+  std::sort(constraints.begin(), constraints.end());
+  if (constraints != d_coverConstraints)
+  {
+    d_covers.clear();
+    d_coverConstraints = std::move(constraints);
+  }
+}
+
+void CDCAC::clearCaches()
+{
+  d_discriminants.clear();
+  d_resultants.clear();
+  d_roots.clear();
+  d_infeasibleRegions.clear();
+  d_covers.clear();
+  d_coverConstraints.clear();
+}
+
+CDCAC::Statistics::Statistics()
+    : d_discriminantHits("nl::cad::cache::discriminantHits", 0),
+      d_resultantHits("nl::cad::cache::resultantHits", 0),
+      d_rootHits("nl::cad::cache::rootHits", 0),
+      d_intervalHits("nl::cad::cache::intervalHits", 0),
+      d_coverHits("nl::cad::cache::coverHits", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_discriminantHits);
+  smtStatisticsRegistry()->registerStat(&d_resultantHits);
+  smtStatisticsRegistry()->registerStat(&d_rootHits);
+  smtStatisticsRegistry()->registerStat(&d_intervalHits);
+  smtStatisticsRegistry()->registerStat(&d_coverHits);
+}
+
+CDCAC::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_discriminantHits);
+  smtStatisticsRegistry()->unregisterStat(&d_resultantHits);
+  smtStatisticsRegistry()->unregisterStat(&d_rootHits);
+  smtStatisticsRegistry()->unregisterStat(&d_intervalHits);
+  smtStatisticsRegistry()->unregisterStat(&d_coverHits);
+}
+
 void CDCAC::pruneRedundantIntervals(std::vector<CACInterval>& intervals)
 {
   if (isProofEnabled())
@@ -24,12 +24,14 @@
 
 #include <poly/polyxx.h>
 
+#include <map>
 #include <vector>
 
 #include "theory/arith/nl/cad/cdcac_utils.h"
 #include "theory/arith/nl/cad/constraints.h"
 #include "theory/arith/nl/cad/proof_generator.h"
 #include "theory/arith/nl/cad/variable_ordering.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -170,12 +172,36 @@ class CDCAC
    * Check whether the polynomial has a real root above the given value (when
    * evaluated over the current assignment).
    */
-  bool hasRootAbove(const poly::Polynomial& p, const poly::Value& val) const;
+  bool hasRootAbove(const poly::Polynomial& p, const poly::Value& val);
   /**
    * Check whether the polynomial has a real root below the given value (when
    * evaluated over the current assignment).
    */
-  bool hasRootBelow(const poly::Polynomial& p, const poly::Value& val) const;
+  bool hasRootBelow(const poly::Polynomial& p, const poly::Value& val);
+
+  /** The values of the assigned variables, in the variable ordering. */
+  using AssignmentPrefix = std::vector<poly::Value>;
+  AssignmentPrefix assignmentPrefix() const;
+
+  /**
+   * Wrappers around the libpoly routines that use the caches below if
+   * options::nlCadCache() is set.
+   */
+  std::vector<poly::Value> isolateRealRoots(const poly::Polynomial& p);
+  std::vector<poly::Interval> infeasibleRegions(const poly::Polynomial& p,
+                                                poly::SignCondition sc,
+                                                const Node& n);
+  poly::Polynomial cachedDiscriminant(const poly::Polynomial& p);
+  poly::Polynomial cachedResultant(const poly::Polynomial& p,
+                                   const poly::Polynomial& q);
+
+  /**
+   * Clears the cached coverings if the constraints differ from the ones they
+   * were computed for.
+   */
+  void syncCoverCache();
+  /** Clears all caches. */
+  void clearCaches();
 
   /**
    * Sort intervals according to section 4.4.1. and removes fully redundant
@@ -204,6 +230,39 @@ class CDCAC
 
   /** The proof generator */
   std::unique_ptr<CADProofGenerator> d_proof;
+
+  /**
+   * Caches that persist across checks. Polynomials depend on the variable
+   * ordering, hence all of them are cleared when it changes. Each cache is
+   * cleared when it grows beyond s_maxCacheSize entries.
+   */
+  std::map<poly::Polynomial, poly::Polynomial> d_discriminants;
+  std::map<std::pair<poly::Polynomial, poly::Polynomial>, poly::Polynomial>
+      d_resultants;
+  std::map<std::pair<poly::Polynomial, AssignmentPrefix>,
+           std::vector<poly::Value>>
+      d_roots;
+  std::map<std::pair<Node, AssignmentPrefix>, std::vector<poly::Interval>>
+      d_infeasibleRegions;
+  /** Unsat coverings by assignment prefix for d_coverConstraints. */
+  std::map<AssignmentPrefix, std::vector<CACInterval>> d_covers;
+  /** The (sorted) constraints d_covers was computed for. */
+  std::vector<Node> d_coverConstraints;
+  static const std::size_t s_maxCacheSize;
+
+  /** The number of lookups answered by each of the caches above. */
+  class Statistics
+  {
+   public:
+    IntStat d_discriminantHits;
+    IntStat d_resultantHits;
+    IntStat d_rootHits;
+    IntStat d_intervalHits;
+    IntStat d_coverHits;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
 };
 
 }  // namespace cad
@@ -0,0 +1,243 @@
+/*********************                                                        */
+/*! \file batch_contractor.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Evaluates all contraction candidates over floating-point intervals.
+ **/
+
+#include "theory/arith/nl/icp/batch_contractor.h"
+
+#ifdef CVC4_POLY_IMP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+namespace {
+
+constexpr double s_inf = std::numeric_limits<double>::infinity();
+
+/**
+ * Round the result of a single operation down or up. Operations are rounded to
+ * nearest, hence moving to the next double is sufficient. NaN only results
+ * from adding opposite infinities and is replaced by the unbounded value.
+ */
+inline double down(double d)
+{
+  return std::isnan(d) ? -s_inf : std::nextafter(d, -s_inf);
+}
+inline double up(double d)
+{
+  return std::isnan(d) ? s_inf : std::nextafter(d, s_inf);
+}
+
+/** Multiply two bounds, where zero times infinity is zero. */
+inline double mulBound(double a, double b)
+{
+  return (a == 0 || b == 0) ? 0 : a * b;
+}
+
+/** Multiply the intervals [al, au] and [bl, bu] into [l, u]. */
+inline void mul(
+    double al, double au, double bl, double bu, double& l, double& u)
+{
+  double p0 = mulBound(al, bl);
+  double p1 = mulBound(al, bu);
+  double p2 = mulBound(au, bl);
+  double p3 = mulBound(au, bu);
+  l = down(std::min(std::min(p0, p1), std::min(p2, p3)));
+  u = up(std::max(std::max(p0, p1), std::max(p2, p3)));
+}
+
+/** A lower bound of x^k, for x >= 0. */
+inline double powAbsDown(double x, std::size_t k)
+{
+  double res = 1;
+  for (std::size_t i = 0; i < k; ++i) res = down(mulBound(res, x));
+  return std::max(res, 0.0);
+}
+/** An upper bound of x^k, for x >= 0. */
+inline double powAbsUp(double x, std::size_t k)
+{
+  double res = 1;
+  for (std::size_t i = 0; i < k; ++i) res = up(mulBound(res, x));
+  return res;
+}
+
+/** Compute the interval [l, u]^k into [rl, ru]. */
+inline void pow(double l, double u, std::size_t k, double& rl, double& ru)
+{
+  if (k % 2 == 1)
+  {
+    rl = l >= 0 ? powAbsDown(l, k) : -powAbsUp(-l, k);
+    ru = u >= 0 ? powAbsUp(u, k) : -powAbsDown(-u, k);
+  }
+  else if (l >= 0)
+  {
+    rl = powAbsDown(l, k);
+    ru = powAbsUp(u, k);
+  }
+  else if (u <= 0)
+  {
+    rl = powAbsDown(-u, k);
+    ru = powAbsUp(-l, k);
+  }
+  else
+  {
+    rl = 0;
+    ru = std::max(powAbsUp(-l, k), powAbsUp(u, k));
+  }
+}
+
+/** A double lower bound of a (finite) value. */
+double lowerBound(const poly::Value& v)
+{
+  if (is_minus_infinity(v) || poly::is_algebraic_number(v)) return -s_inf;
+  return down(lp_value_to_double(v.get_internal()));
+}
+/** A double upper bound of a (finite) value. */
+double upperBound(const poly::Value& v)
+{
+  if (is_plus_infinity(v) || poly::is_algebraic_number(v)) return s_inf;
+  return up(lp_value_to_double(v.get_internal()));
+}
+
+}  // namespace
+
+void BatchContractor::compile(const std::vector<Candidate>& candidates)
+{
+  d_slots.clear();
+  d_lower.clear();
+  d_upper.clear();
+  d_candLhs.clear();
+  d_candRel.clear();
+  d_candMultLower.clear();
+  d_candMultUpper.clear();
+  d_candTerms.clear();
+  d_termCoeffLower.clear();
+  d_termCoeffUpper.clear();
+  d_termFactors.clear();
+  d_factorSlot.clear();
+  d_factorExp.clear();
+
+  lp_polynomial_traverse_f f =
+      [](const lp_polynomial_context_t* ctx, lp_monomial_t* m, void* data) {
+        BatchContractor* bc = static_cast<BatchContractor*>(data);
+        double coeff = mpz_get_d(m->a);
+        bc->d_termCoeffLower.emplace_back(down(coeff));
+        bc->d_termCoeffUpper.emplace_back(up(coeff));
+        bc->d_termFactors.emplace_back(bc->d_factorSlot.size());
+        for (std::size_t i = 0; i < m->n; ++i)
+        {
+          bc->d_factorSlot.emplace_back(bc->slot(m->p[i].x));
+          bc->d_factorExp.emplace_back(m->p[i].d);
+        }
+      };
+  for (const auto& c : candidates)
+  {
+    d_candLhs.emplace_back(slot(c.lhs.get_internal()));
+    d_candRel.emplace_back(c.rel);
+    double mult = mpq_get_d(c.rhsmult.get_internal());
+    d_candMultLower.emplace_back(down(mult));
+    d_candMultUpper.emplace_back(up(mult));
+    d_candTerms.emplace_back(d_termFactors.size());
+    lp_polynomial_traverse(c.rhs.get_internal(), f, this);
+  }
+  d_candTerms.emplace_back(d_termFactors.size());
+  d_termFactors.emplace_back(d_factorSlot.size());
+}
+
+void BatchContractor::load(const poly::IntervalAssignment& ia)
+{
+  for (const auto& s : d_slots)
+  {
+    poly::Variable v(s.first);
+    if (ia.has(v))
+    {
+      update(v, ia.get(v));
+    }
+    else
+    {
+      d_lower[s.second] = -s_inf;
+      d_upper[s.second] = s_inf;
+    }
+  }
+}
+
+void BatchContractor::update(const poly::Variable& v, const poly::Interval& i)
+{
+  auto it = d_slots.find(v.get_internal());
+  if (it == d_slots.end()) return;
+  d_lower[it->second] = lowerBound(get_lower(i));
+  d_upper[it->second] = upperBound(get_upper(i));
+}
+
+void BatchContractor::evaluate(std::vector<bool>& mayContract) const
+{
+  std::size_t numCands = d_candLhs.size();
+  mayContract.assign(numCands, false);
+  for (std::size_t c = 0; c < numCands; ++c)
+  {
+    double l = 0;
+    double u = 0;
+    for (std::size_t t = d_candTerms[c]; t < d_candTerms[c + 1]; ++t)
+    {
+      double tl = d_termCoeffLower[t];
+      double tu = d_termCoeffUpper[t];
+      for (std::size_t f = d_termFactors[t]; f < d_termFactors[t + 1]; ++f)
+      {
+        double fl, fu;
+        std::size_t s = d_factorSlot[f];
+        pow(d_lower[s], d_upper[s], d_factorExp[f], fl, fu);
+        mul(tl, tu, fl, fu, tl, tu);
+      }
+      l = down(l + tl);
+      u = up(u + tu);
+    }
+    mul(l, u, d_candMultLower[c], d_candMultUpper[c], l, u);
+    switch (d_candRel[c])
+    {
+      case poly::SignCondition::LT:
+      case poly::SignCondition::LE: l = -s_inf; break;
+      case poly::SignCondition::GT:
+      case poly::SignCondition::GE: u = s_inf; break;
+      case poly::SignCondition::EQ: break;
+      case poly::SignCondition::NE: Assert(false); continue;
+    }
+    std::size_t lhs = d_candLhs[c];
+    mayContract[c] = l > d_lower[lhs] || u < d_upper[lhs];
+  }
+}
+
+std::size_t BatchContractor::slot(lp_variable_t v)
+{
+  auto it = d_slots.emplace(v, d_lower.size());
+  if (it.second)
+  {
+    d_lower.emplace_back(-s_inf);
+    d_upper.emplace_back(s_inf);
+  }
+  return it.first->second;
+}
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif
@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file batch_contractor.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Evaluates all contraction candidates over floating-point intervals.
+ **/
+
+#ifndef CVC4__THEORY__ARITH__ICP__BATCH_CONTRACTOR_H
+#define CVC4__THEORY__ARITH__ICP__BATCH_CONTRACTOR_H
+
+#include "cvc4_private.h"
+
+#ifdef CVC4_POLY_IMP
+#include <poly/polyxx.h>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "theory/arith/nl/icp/candidate.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+/**
+ * Evaluates the right hand sides of all candidates of a propagation round over
+ * double intervals and decides which candidates may contract their left hand
+ * side. Only these are then propagated exactly by Candidate::propagate().
+ *
+ * All arithmetic is rounded outward, hence the double interval computed for a
+ * candidate encloses the real range of its right hand side over the current
+ * bounds. If it does not cut the current interval of the left hand side, the
+ * exact propagation can not do so either, up to the order of evaluation that
+ * poly::evaluate() uses.
+ *
+ * The candidates are compiled into flat arrays (terms per candidate, factors
+ * per term) and the bounds of all variables are kept in two arrays indexed by
+ * a slot per variable, such that a round of evaluations runs over contiguous
+ * memory only.
+ */
+class BatchContractor
+{
+ public:
+  /** Compile the given candidates. Resets all bounds to be unbounded. */
+  void compile(const std::vector<Candidate>& candidates);
+  /** Load the bounds of all variables from the interval assignment. */
+  void load(const poly::IntervalAssignment& ia);
+  /** Update the bounds of a single variable. */
+  void update(const poly::Variable& v, const poly::Interval& i);
+  /**
+   * Evaluate all candidates over the current bounds and store for each of
+   * them whether it may contract its left hand side.
+   */
+  void evaluate(std::vector<bool>& mayContract) const;
+
+ private:
+  /** Returns the slot of v, adding it if necessary. */
+  std::size_t slot(lp_variable_t v);
+
+  /** Maps variables to their slot */
+  std::unordered_map<lp_variable_t, std::size_t> d_slots;
+  /** Lower and upper bounds by slot */
+  std::vector<double> d_lower;
+  std::vector<double> d_upper;
+
+  /** Slot of the left hand side by candidate */
+  std::vector<std::size_t> d_candLhs;
+  /** Relation by candidate */
+  std::vector<poly::SignCondition> d_candRel;
+  /** Bounds of the rational multiplier by candidate */
+  std::vector<double> d_candMultLower;
+  std::vector<double> d_candMultUpper;
+  /** First term by candidate, with a sentinel at the end */
+  std::vector<std::size_t> d_candTerms;
+
+  /** Bounds of the coefficient by term */
+  std::vector<double> d_termCoeffLower;
+  std::vector<double> d_termCoeffUpper;
+  /** First factor by term, with a sentinel at the end */
+  std::vector<std::size_t> d_termFactors;
+
+  /** Slot of the variable by factor */
+  std::vector<std::size_t> d_factorSlot;
+  /** Exponent by factor */
+  std::vector<std::size_t> d_factorExp;
+};
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif
+
+#endif
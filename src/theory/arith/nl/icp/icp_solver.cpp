@@ -19,6 +19,8 @@
 #include "base/check.h"
 #include "base/output.h"
 #include "expr/node_algorithm.h"
+#include "options/arith_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/arith/inference_manager.h"
 #include "theory/arith/nl/poly_conversion.h"
@@ -216,10 +218,30 @@ PropagationResult ICPSolver::doPropagationRound()
                   << IAWrapper{d_state.d_assignment, d_mapper} << std::endl;
   Trace("nl-icp") << "Current budget: " << d_budget << std::endl;
   PropagationResult res = PropagationResult::NOT_CHANGED;
-  for (const auto& c : d_state.d_candidates)
+  // Candidates are skipped if their floating-point evaluation over the bounds
+  // at the start of this round shows that they can not contract. Bounds only
+  // shrink within a round, so any candidate skipped wrongly is reconsidered
+  // in the next round.
+  bool batch = options::nlICPBatch();
+  std::vector<bool> mayContract;
+  if (batch)
   {
+    d_batch.evaluate(mayContract);
+  }
+  for (std::size_t i = 0, n = d_state.d_candidates.size(); i < n; ++i)
+  {
+    const Candidate& c = d_state.d_candidates[i];
     --d_budget;
+    if (batch && !mayContract[i])
+    {
+      ++d_statistics.d_numSkippedCandidates;
+      continue;
+    }
     PropagationResult cres = c.propagate(d_state.d_assignment, 100);
+    if (batch && cres != PropagationResult::NOT_CHANGED)
+    {
+      d_batch.update(c.lhs, d_state.d_assignment.get(c.lhs));
+    }
     switch (cres)
     {
       case PropagationResult::NOT_CHANGED: break;
@@ -326,6 +348,11 @@ void ICPSolver::check()
 {
   initOrigins();
   d_state.d_assignment = getBounds(d_mapper, d_state.d_bounds);
+  if (options::nlICPBatch())
+  {
+    d_batch.compile(d_state.d_candidates);
+    d_batch.load(d_state.d_assignment);
+  }
   bool did_progress = false;
   bool progress = false;
   do
@@ -366,6 +393,17 @@ void ICPSolver::check()
   }
 }
 
+ICPSolver::Statistics::Statistics()
+    : d_numSkippedCandidates("nl::icp::skippedCandidates", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numSkippedCandidates);
+}
+
+ICPSolver::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numSkippedCandidates);
+}
+
 #else /* CVC4_POLY_IMP */
 
 void ICPSolver::reset(const std::vector<Node>& assertions)
@@ -23,10 +23,12 @@
 
 #include "expr/node.h"
 #include "theory/arith/bound_inference.h"
+#include "theory/arith/nl/icp/batch_contractor.h"
 #include "theory/arith/nl/icp/candidate.h"
 #include "theory/arith/nl/icp/contraction_origins.h"
 #include "theory/arith/nl/icp/intersection.h"
 #include "theory/arith/nl/poly_conversion.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -94,12 +96,23 @@ class ICPSolver
   std::map<Node, std::vector<Candidate>> d_candidateCache;
   /** The current state */
   ICPState d_state;
+  /** Selects the candidates to propagate, see options::nlICPBatch() */
+  BatchContractor d_batch;
 
   /** The remaining budget */
   std::int64_t d_budget = 0;
   /** The budget increment for new candidates and strong contractions */
   static constexpr std::int64_t d_budgetIncrement = 10;
 
+  struct Statistics
+  {
+    /** number of candidates the batch evaluation showed can not contract */
+    IntStat d_numSkippedCandidates;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+
   /** Collect all variables from a node */
   std::vector<Node> collectVariables(const Node& n) const;
   /** Construct all possible candidates from a given theory atom */
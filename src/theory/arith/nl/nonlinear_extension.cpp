@@ -17,6 +17,8 @@
 
 #include "theory/arith/nl/nonlinear_extension.h"
 
+#include <chrono>
+
 #include "options/arith_options.h"
 #include "theory/arith/arith_state.h"
 #include "theory/arith/bound_inference.h"
@@ -546,11 +548,19 @@ void NonlinearExtension::runStrategy(Theory::Effort effort,
   }
 
   auto steps = d_strategy.getStrategy();
+  bool adaptive = options::nlAdaptiveStrategy();
   bool stop = false;
   while (!stop && steps.hasNext())
   {
     InferStep step = steps.next();
     Trace("nl-strategy") << "Step " << step << std::endl;
+    std::size_t lemmas = 0;
+    std::chrono::steady_clock::time_point start;
+    if (adaptive)
+    {
+      lemmas = d_im.numPendingLemmas() + d_im.numWaitingLemmas();
+      start = std::chrono::steady_clock::now();
+    }
     switch (step)
     {
       case InferStep::BREAK: stop = d_im.hasPendingLemma(); break;
@@ -608,6 +618,16 @@ void NonlinearExtension::runStrategy(Theory::Effort effort,
         d_trSlv.checkTranscendentalTangentPlanes();
         break;
     }
+    if (adaptive && step != InferStep::BREAK)
+    {
+      std::size_t newLemmas =
+          d_im.numPendingLemmas() + d_im.numWaitingLemmas();
+      auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+      d_strategy.recordStep(step,
+                            newLemmas > lemmas ? newLemmas - lemmas : 0,
+                            micros.count());
+    }
   }
 
   Trace("nl-ext") << "finished strategy" << std::endl;
@@ -14,9 +14,11 @@
 
 #include "theory/arith/nl/strategy.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "base/check.h"
+#include "base/output.h"
 #include "options/arith_options.h"
 
 namespace CVC4 {
@@ -67,6 +69,43 @@ inline StepSequence& operator<<(StepSequence& steps, InferStep s)
   steps.emplace_back(s);
   return steps;
 }
+
+/**
+ * Whether the step only adds lemmas from a scheme that does not depend on
+ * other steps having run before, and may hence be reordered.
+ *
+ * NL_MONOMIAL_SIGN is not reorderable, as the magnitude steps read the
+ * monomials it marked as processed (d_ms_proc), and NL_RESOLUTION_BOUNDS
+ * uses the bound inferences (d_ci) of NL_MONOMIAL_INFER_BOUNDS. Segments
+ * with steps that are not reorderable stay in place, and no other segment is
+ * moved across them.
+ */
+bool isReorderable(InferStep step)
+{
+  switch (step)
+  {
+    case InferStep::NL_FACTORING:
+    case InferStep::NL_MONOMIAL_INFER_BOUNDS:
+    case InferStep::NL_MONOMIAL_MAGNITUDE0:
+    case InferStep::NL_MONOMIAL_MAGNITUDE1:
+    case InferStep::NL_MONOMIAL_MAGNITUDE2:
+    case InferStep::NL_TANGENT_PLANES:
+    case InferStep::TRANS_MONOTONIC: return true;
+    default: return false;
+  }
+}
+
+/** Whether the segment ends with a BREAK and may be reordered otherwise */
+bool isReorderable(const StepSequence& segment)
+{
+  if (segment.size() < 2 || segment.back() != InferStep::BREAK)
+  {
+    return false;
+  }
+  return std::all_of(segment.begin(), segment.end() - 1, [](InferStep s) {
+    return isReorderable(s);
+  });
+}
 }  // namespace
 
 void Interleaving::add(const StepSequence& ss, std::size_t constant)
@@ -167,7 +206,88 @@ void Strategy::initializeStrategy()
 }
 StepGenerator Strategy::getStrategy()
 {
-  return StepGenerator(d_interleaving.get());
+  const StepSequence& steps = d_interleaving.get();
+  if (!options::nlAdaptiveStrategy())
+  {
+    return StepGenerator(steps);
+  }
+  d_reordered = reorder(steps);
+  return StepGenerator(d_reordered);
+}
+
+void Strategy::recordStep(InferStep step,
+                          std::size_t lemmas,
+                          std::uint64_t micros)
+{
+  StepRecord& r = d_records[step];
+  r.d_lemmas = r.d_lemmas * s_decay + lemmas;
+  r.d_micros = r.d_micros * s_decay + micros;
+}
+
+StepSequence Strategy::reorder(const StepSequence& steps) const
+{
+  StepSequence res;
+  std::vector<StepSequence> run;
+  auto flushRun = [this, &res, &run]() {
+    std::stable_sort(run.begin(),
+                     run.end(),
+                     [this](const StepSequence& a, const StepSequence& b) {
+                       return effectiveness(a) > effectiveness(b);
+                     });
+    for (const auto& segment : run)
+    {
+      res.insert(res.end(), segment.begin(), segment.end());
+    }
+    run.clear();
+  };
+  StepSequence segment;
+  for (InferStep step : steps)
+  {
+    segment.emplace_back(step);
+    if (step != InferStep::BREAK)
+    {
+      continue;
+    }
+    if (isReorderable(segment))
+    {
+      run.emplace_back(segment);
+    }
+    else
+    {
+      flushRun();
+      res.insert(res.end(), segment.begin(), segment.end());
+    }
+    segment.clear();
+  }
+  flushRun();
+  res.insert(res.end(), segment.begin(), segment.end());
+  if (Trace.isOn("nl-strategy"))
+  {
+    Trace("nl-strategy") << "Reordered steps:";
+    for (InferStep step : res)
+    {
+      Trace("nl-strategy") << " " << step;
+    }
+    Trace("nl-strategy") << std::endl;
+  }
+  return res;
+}
+
+double Strategy::effectiveness(const StepSequence& segment) const
+{
+  // Steps that never ran look most effective, such that they are tried early.
+  double lemmas = 1;
+  double micros = 1;
+  for (InferStep step : segment)
+  {
+    auto it = d_records.find(step);
+    if (it != d_records.end())
+    {
+      lemmas += it->second.d_lemmas;
+      micros += it->second.d_micros;
+    }
+  }
+  return lemmas / micros;
 }
 
 }  // namespace nl
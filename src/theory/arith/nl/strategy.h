@@ -15,7 +15,9 @@
 #ifndef CVC4__THEORY__ARITH__NL__STRATEGY_H
 #define CVC4__THEORY__ARITH__NL__STRATEGY_H
 
+#include <cstdint>
 #include <iosfwd>
+#include <map>
 #include <vector>
 
 namespace CVC4 {
@@ -164,10 +166,42 @@ class Strategy
   void initializeStrategy();
   /** Retrieve the strategy for the given effort e */
   StepGenerator getStrategy();
+  /**
+   * Record that a run of the given step produced the given number of lemmas
+   * in the given number of microseconds.
+   */
+  void recordStep(InferStep step, std::size_t lemmas, std::uint64_t micros);
 
  private:
+  /**
+   * The decayed yield and cost of a step. Every record first scales the old
+   * values by s_decay, such that recent runs dominate.
+   */
+  struct StepRecord
+  {
+    double d_lemmas = 0;
+    double d_micros = 0;
+  };
+  static constexpr double s_decay = 0.9;
+
+  /**
+   * Reorders the given sequence, see options::nlAdaptiveStrategy(). The
+   * sequence is split into segments that end with a BREAK. Maximal runs of
+   * segments that only consist of independent lemma schemes are sorted by
+   * decreasing number of lemmas per time. As every segment is still run if
+   * the previous ones did not produce a lemma, this does not affect
+   * completeness.
+   */
+  StepSequence reorder(const StepSequence& steps) const;
+  /** The number of lemmas per time of the given segment */
+  double effectiveness(const StepSequence& segment) const;
+
   /** The interleaving for this strategy */
   Interleaving d_interleaving;
+  /** The records by step */
+  std::map<InferStep, StepRecord> d_records;
+  /** The reordered sequence returned by the last getStrategy() */
+  StepSequence d_reordered;
 };
 
 }  // namespace nl
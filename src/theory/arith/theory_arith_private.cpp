@@ -156,6 +156,7 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_fullCheckCounter(0),
       d_cutCount(c, 0),
       d_cutInContext(c),
+      d_nativeCutAge(c),
       d_likelyIntegerInfeasible(c, false),
       d_guessedCoeffSet(c, false),
       d_guessedCoeffs(),
@@ -277,6 +278,9 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_boundComputationTime("theory::arith::bound::time")
   , d_boundComputations("theory::arith::bound::boundComputations",0)
   , d_boundPropagations("theory::arith::bound::boundPropagations",0)
+  , d_impliedBoundsSingleton("theory::arith::bound::impliedBySingletonRows",0)
+  , d_impliedBoundsFull("theory::arith::bound::impliedByFullRows",0)
+  , d_singletonsFiltered("theory::arith::bound::singletonRowsFiltered",0)
   , d_unknownChecks("theory::arith::status::unknowns", 0)
   , d_maxUnknownsInARow("theory::arith::status::maxUnknownsInARow", 0)
   , d_avgUnknownsInARow("theory::arith::status::avgUnknownsInARow")
@@ -322,6 +326,8 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_replayAttemptFailed("theory::arith::z::replayAttemptFailed",0)
   , d_cutsRejectedDuringReplay("theory::arith::z::approx::replay::cuts::rejected", 0)
   , d_cutsRejectedDuringLemmas("theory::arith::z::approx::external::cuts::rejected", 0)
+  , d_nativeGomoryCuts("theory::arith::nativeGomoryCuts", 0)
+  , d_nativeGomoryCutsRejected("theory::arith::nativeGomoryCuts::rejected", 0)
   , d_satPivots("theory::arith::pivots::sat")
   , d_unsatPivots("theory::arith::pivots::unsat")
   , d_unknownPivots("theory::arith::pivots::unknown")
@@ -356,6 +362,9 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_boundComputationTime);
   smtStatisticsRegistry()->registerStat(&d_boundComputations);
   smtStatisticsRegistry()->registerStat(&d_boundPropagations);
+  smtStatisticsRegistry()->registerStat(&d_impliedBoundsSingleton);
+  smtStatisticsRegistry()->registerStat(&d_impliedBoundsFull);
+  smtStatisticsRegistry()->registerStat(&d_singletonsFiltered);
 
   smtStatisticsRegistry()->registerStat(&d_unknownChecks);
   smtStatisticsRegistry()->registerStat(&d_maxUnknownsInARow);
@@ -415,6 +424,8 @@ TheoryArithPrivate::Statistics::Statistics()
 
   smtStatisticsRegistry()->registerStat(&d_cutsRejectedDuringReplay);
   smtStatisticsRegistry()->registerStat(&d_cutsRejectedDuringLemmas);
+  smtStatisticsRegistry()->registerStat(&d_nativeGomoryCuts);
+  smtStatisticsRegistry()->registerStat(&d_nativeGomoryCutsRejected);
 
   smtStatisticsRegistry()->registerStat(&d_solveIntModelsAttempts);
   smtStatisticsRegistry()->registerStat(&d_solveIntModelsSuccessful);
@@ -449,6 +460,9 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_boundComputationTime);
   smtStatisticsRegistry()->unregisterStat(&d_boundComputations);
   smtStatisticsRegistry()->unregisterStat(&d_boundPropagations);
+  smtStatisticsRegistry()->unregisterStat(&d_impliedBoundsSingleton);
+  smtStatisticsRegistry()->unregisterStat(&d_impliedBoundsFull);
+  smtStatisticsRegistry()->unregisterStat(&d_singletonsFiltered);
 
   smtStatisticsRegistry()->unregisterStat(&d_unknownChecks);
   smtStatisticsRegistry()->unregisterStat(&d_maxUnknownsInARow);
@@ -508,6 +522,8 @@ TheoryArithPrivate::Statistics::~Statistics(){
 
   smtStatisticsRegistry()->unregisterStat(&d_cutsRejectedDuringReplay);
   smtStatisticsRegistry()->unregisterStat(&d_cutsRejectedDuringLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_nativeGomoryCuts);
+  smtStatisticsRegistry()->unregisterStat(&d_nativeGomoryCutsRejected);
 
 
   smtStatisticsRegistry()->unregisterStat(&d_solveIntModelsAttempts);
@@ -1564,6 +1580,175 @@ bool TheoryArithPrivate::canSafelyAvoidEqualitySetup(TNode equality){
   return d_partialModel.hasArithVar(equality[0]);
 }
 
+bool TheoryArithPrivate::nativeGomoryRowIsUsable(ArithVar basic) const
+{
+  if (!isInteger(basic))
+  {
+    return false;
+  }
+  const DeltaRational& d = d_partialModel.getAssignment(basic);
+  if (!d.infinitesimalIsZero() || d.isIntegral())
+  {
+    return false;
+  }
+  context::CDHashMap<ArithVar, uint32_t, std::hash<ArithVar> >::const_iterator
+      age = d_nativeCutAge.find(basic);
+  if (age != d_nativeCutAge.end()
+      && (*age).second >= options::arithNativeCutAge())
+  {
+    return false;
+  }
+
+  for (Tableau::RowIterator ri = d_tableau.basicRowIterator(basic);
+       !ri.atEnd();
+       ++ri)
+  {
+    ArithVar v = (*ri).getColVar();
+    if (v == basic)
+    {
+      continue;
+    }
+    ConstraintP bound = NullConstraint;
+    if (d_partialModel.cmpAssignmentLowerBound(v) == 0)
+    {
+      bound = d_partialModel.getLowerBoundConstraint(v);
+    }
+    else if (d_partialModel.cmpAssignmentUpperBound(v) == 0)
+    {
+      bound = d_partialModel.getUpperBoundConstraint(v);
+    }
+    if (bound == NullConstraint || !bound->getValue().infinitesimalIsZero())
+    {
+      return false;
+    }
+    if (isInteger(v) && !bound->getValue().isIntegral())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+TrustNode TheoryArithPrivate::nativeGomoryCut()
+{
+  // Select the most fractional candidate, breaking ties by row length.
+  ArithVar basic = ARITHVAR_SENTINEL;
+  Rational bestFrac;
+  uint32_t bestLength = 0;
+  for (Tableau::BasicIterator bi = d_tableau.beginBasic(),
+                              bend = d_tableau.endBasic();
+       bi != bend;
+       ++bi)
+  {
+    ArithVar b = *bi;
+    if (!nativeGomoryRowIsUsable(b))
+    {
+      continue;
+    }
+    Rational f0 =
+        d_partialModel.getAssignment(b).getNoninfinitesimalPart().floor_frac();
+    Rational frac = std::min(f0, Rational(1) - f0);
+    uint32_t length = d_tableau.basicRowLength(b);
+    if (basic == ARITHVAR_SENTINEL || frac > bestFrac
+        || (frac == bestFrac && length < bestLength))
+    {
+      basic = b;
+      bestFrac = frac;
+      bestLength = length;
+    }
+  }
+  if (basic == ARITHVAR_SENTINEL)
+  {
+    return TrustNode::null();
+  }
+
+  uint32_t age = 0;
+  if (d_nativeCutAge.find(basic) != d_nativeCutAge.end())
+  {
+    age = d_nativeCutAge[basic];
+  }
+  d_nativeCutAge[basic] = age + 1;
+
+  // The row reads basic = sum_j a_j x_j.  Shifting each nonbasic x_j to the
+  // bound it sits at, with t_j = x_j - l_j or t_j = u_j - x_j, gives
+  // basic = beta + sum_j alpha_j t_j with t_j >= 0 and beta the current
+  // (fractional) assignment of basic.  In the textbook form
+  // basic + sum_j a_j t_j = beta we have a_j = -alpha_j, and the Gomory
+  // mixed-integer cut is sum_j g_j t_j >= 1, which the current assignment
+  // (t = 0) violates.
+  const Rational& beta =
+      d_partialModel.getAssignment(basic).getNoninfinitesimalPart();
+  const Rational f0 = beta.floor_frac();
+  const Rational oneMinusF0 = Rational(1) - f0;
+
+  DenseMap<Rational> lhs;
+  Rational rhs(1);
+  ConstraintCPVec exp;
+  for (Tableau::RowIterator ri = d_tableau.basicRowIterator(basic);
+       !ri.atEnd();
+       ++ri)
+  {
+    const Tableau::Entry& e = *ri;
+    ArithVar v = e.getColVar();
+    if (v == basic)
+    {
+      continue;
+    }
+    bool atLower = d_partialModel.cmpAssignmentLowerBound(v) == 0;
+    ConstraintP bound = atLower ? d_partialModel.getLowerBoundConstraint(v)
+                                : d_partialModel.getUpperBoundConstraint(v);
+    const Rational& b = bound->getValue().getNoninfinitesimalPart();
+    Rational a = atLower ? -e.getCoefficient() : e.getCoefficient();
+
+    Rational g;
+    if (isInteger(v))
+    {
+      Rational fj = a.floor_frac();
+      g = (fj <= f0) ? fj / f0 : (Rational(1) - fj) / oneMinusF0;
+    }
+    else
+    {
+      g = (a.sgn() >= 0) ? a / f0 : -a / oneMinusF0;
+    }
+    if (g.isZero())
+    {
+      continue;
+    }
+    exp.push_back(bound);
+    if (atLower)
+    {
+      lhs.set(v, g);
+      rhs += g * b;
+    }
+    else
+    {
+      lhs.set(v, -g);
+      rhs -= g * b;
+    }
+  }
+
+  if (lhs.empty() || !complexityBelow(lhs, options::lemmaRejectCutSize()))
+  {
+    ++(d_statistics.d_nativeGomoryCutsRejected);
+    return TrustNode::null();
+  }
+  Node sum = toSumNode(d_partialModel, lhs);
+  if (sum.isNull())
+  {
+    ++(d_statistics.d_nativeGomoryCutsRejected);
+    return TrustNode::null();
+  }
+
+  NodeManager* nm = NodeManager::currentNM();
+  Node cut =
+      Rewriter::rewrite(nm->mkNode(kind::GEQ, sum, mkRationalNode(rhs)));
+  Node lemma = Constraint::externalExplainByAssertions(exp).impNode(cut);
+  Debug("arith::cuts") << "native gomory cut on " << basic << ": " << lemma
+                       << endl;
+  // TODO (project #37): justify the cut
+  return TrustNode::mkTrustLemma(lemma, nullptr);
+}
+
 Comparison TheoryArithPrivate::mkIntegerEqualityFromAssignment(ArithVar v){
   const DeltaRational& beta = d_partialModel.getAssignment(v);
 
@@ -3117,38 +3302,60 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
   SimplexDecisionProcedure& simplex = selectSimplex(true);
 
   bool useApprox = options::useApprox() && ApproximateSimplex::enabled() && getSolveIntegerResource();
+  // the built-in floating-point simplex is used unless glpk is
+  bool useFloat = !useApprox && options::approxFloat();
+  bool raceFloat = useFloat && options::approxFloatRace();
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation() approx"
     << " " <<  options::useApprox()
     << " " << ApproximateSimplex::enabled()
     << " " << useApprox
+    << " " << useFloat
     << " " << safeToCallApprox()
     << endl;
 
-  bool noPivotLimitPass1 = noPivotLimit && !useApprox;
+  bool noPivotLimitPass1 = noPivotLimit && !useApprox && !useFloat;
+  // A negative pivot cap makes pass1 exact, which would leave nothing for the
+  // floating-point simplex to do.
+  int16_t oldCap = options::arithStandardCheckVarOrderPivots();
+  if(useFloat){
+    static const int16_t pass1Limit = 20;
+    if(oldCap < 0 || oldCap > pass1Limit){
+      options::arithStandardCheckVarOrderPivots.set(pass1Limit);
+    }
+  }
   d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  if(useFloat){
+    options::arithStandardCheckVarOrderPivots.set(oldCap);
+  }
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
 
-  if(d_qflraStatus == Result::SAT_UNKNOWN && useApprox && safeToCallApprox()){
+  if(d_qflraStatus == Result::SAT_UNKNOWN && (useApprox || useFloat) && safeToCallApprox()){
     // pass2: fancy-final
     static const int32_t relaxationLimit = 10000;
-    Assert(ApproximateSimplex::enabled());
+    Assert(useFloat || ApproximateSimplex::enabled());
 
     TreeLog& tl = getTreeLog();
     ApproximateStatistics& stats = getApproxStats();
     ApproximateSimplex* approxSolver =
-      ApproximateSimplex::mkApproximateSimplexSolver(d_partialModel, tl, stats);
+        raceFloat
+            ? ApproximateSimplex::mkFloatSimplexRace(d_partialModel, tl, stats)
+            : useFloat ? ApproximateSimplex::mkFloatSimplexSolver(
+                             d_partialModel, tl, stats)
+                       : ApproximateSimplex::mkApproximateSimplexSolver(
+                             d_partialModel, tl, stats);
 
     approxSolver->setPivotLimit(relaxationLimit);
 
-    if(!d_guessedCoeffSet){
+    // the floating-point simplex only searches for a feasible basis
+    if(!useFloat && !d_guessedCoeffSet){
       d_guessedCoeffs = approxSolver->heuristicOptCoeffs();
       d_guessedCoeffSet = true;
     }
-    if(!d_guessedCoeffs.empty()){
+    if(!useFloat && !d_guessedCoeffs.empty()){
       approxSolver->setOptCoeffs(d_guessedCoeffs);
     }
 
@@ -3675,6 +3882,20 @@ bool TheoryArithPrivate::postCheck(Theory::Effort effortLevel)
       }
     }
 
+    if (!emmittedConflictOrSplit && options::arithNativeCuts()
+        && !proofsEnabled())
+    {
+      TrustNode possibleLemma = nativeGomoryCut();
+      if (!possibleLemma.isNull())
+      {
+        ++(d_statistics.d_nativeGomoryCuts);
+        emmittedConflictOrSplit = true;
+        d_cutCount = d_cutCount + 1;
+        Debug("arith::lemma") << "native gomory cut " << possibleLemma << endl;
+        outputTrustedLemma(possibleLemma);
+      }
+    }
+
     if(!emmittedConflictOrSplit) {
       TrustNode possibleLemma = roundRobinBranch();
       if (!possibleLemma.getNode().isNull())
@@ -4633,12 +4854,12 @@ bool TheoryArithPrivate::propagateMightSucceed(ArithVar v, bool ub) const{
 bool TheoryArithPrivate::attemptSingleton(RowIndex ridx, bool rowUp){
   Debug("arith::prop") << "  attemptSingleton" << ridx;
 
-  const Tableau::Entry* ep;
-  ep = d_linEq.rowLacksBound(ridx, rowUp, ARITHVAR_SENTINEL);
-  Assert(ep != NULL);
+  // The row watches give the only variable lacking a bound without a scan.
+  const Tableau::Entry& e = d_linEq.watchedLacksBound(ridx, rowUp);
+  Assert(&e == d_linEq.rowLacksBound(ridx, rowUp, ARITHVAR_SENTINEL));
 
-  ArithVar v = ep->getColVar();
-  const Rational& coeff = ep->getCoefficient();
+  ArithVar v = e.getColVar();
+  const Rational& coeff = e.getCoefficient();
 
   // 0 = c * v + \sum rest
   // Suppose rowUp
@@ -4657,8 +4878,13 @@ bool TheoryArithPrivate::attemptSingleton(RowIndex ridx, bool rowUp){
   if(propagateMightSucceed(v, vUp)){
     DeltaRational dr = d_linEq.computeRowBound(ridx, rowUp, v);
     DeltaRational bound = dr / (- coeff);
-    return tryToPropagate(ridx, rowUp, v, vUp, bound);
+    if(tryToPropagate(ridx, rowUp, v, vUp, bound)){
+      ++d_statistics.d_impliedBoundsSingleton;
+      return true;
+    }
+    return false;
   }
+  ++d_statistics.d_singletonsFiltered;
   return false;
 }
 
@@ -4699,6 +4925,9 @@ bool TheoryArithPrivate::attemptFull(RowIndex ridx, bool rowUp){
     DeltaRational impliedBound = (slack - contribution)/(-c);
 
     bool success = tryToPropagate(ridx, rowUp, v, vUb, impliedBound);
+    if(success){
+      ++d_statistics.d_impliedBoundsFull;
+    }
     any |= success;
   }
   return any;
@@ -4878,21 +5107,22 @@ bool TheoryArithPrivate::propagateCandidateRow(RowIndex ridx){
   Debug("arith::prop")
     << "propagateCandidateRow " << instance << " attempt " << rowLength << " " <<  hasCount << endl;
 
-  if (rowLength >= options::arithPropagateMaxLength()
-      && Random::getRandom().pickWithProb(
-             1.0 - double(options::arithPropagateMaxLength()) / rowLength))
-  {
-    return false;
-  }
+  // Full rows are scanned for candidates, so long rows are only sampled.
+  // Singleton rows find their candidate through the row watches and only
+  // compute the row bound once a propagation might succeed.
+  bool skipFull = rowLength >= options::arithPropagateMaxLength()
+                  && Random::getRandom().pickWithProb(
+                      1.0 - double(options::arithPropagateMaxLength())
+                                / rowLength);
 
   if(hasCount.lowerBoundCount() == rowLength){
-    success |= attemptFull(ridx, false);
+    if(!skipFull){ success |= attemptFull(ridx, false); }
   }else if(hasCount.lowerBoundCount() + 1 == rowLength){
     success |= attemptSingleton(ridx, false);
   }
 
   if(hasCount.upperBoundCount() == rowLength){
-    success |= attemptFull(ridx, true);
+    if(!skipFull){ success |= attemptFull(ridx, true); }
   }else if(hasCount.upperBoundCount() + 1 == rowLength){
     success |= attemptSingleton(ridx, true);
   }
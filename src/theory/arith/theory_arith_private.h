@@ -21,6 +21,7 @@
 #include <queue>
 #include <vector>
 
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
@@ -248,6 +249,22 @@ private:
    */
   TrustNode dioCutting();
 
+  /**
+   * Derives a Gomory mixed-integer cut from the exact tableau row of a basic
+   * integer variable with a fractional assignment.  Every nonbasic variable
+   * in the row must sit at one of its asserted bounds; those bound
+   * constraints form the antecedent of the returned lemma.
+   *
+   * Among the usable rows the most fractional basic variable is selected,
+   * preferring shorter rows on ties.  Rows that have already produced
+   * options::arithNativeCutAge() cuts in the current context are skipped.
+   *
+   * Returns the null TrustNode if no usable row exists or the cut is
+   * rejected for having overly complex coefficients.
+   */
+  TrustNode nativeGomoryCut();
+  bool nativeGomoryRowIsUsable(ArithVar basic) const;
+
   Comparison mkIntegerEqualityFromAssignment(ArithVar v);
 
   /**
@@ -727,6 +744,8 @@ private:
 
   context::CDO<unsigned> d_cutCount;
   context::CDHashSet<ArithVar, std::hash<ArithVar> > d_cutInContext;
+  /** Number of native Gomory cuts derived from each basic variable. */
+  context::CDHashMap<ArithVar, uint32_t, std::hash<ArithVar> > d_nativeCutAge;
 
   context::CDO<bool> d_likelyIntegerInfeasible;
 
@@ -807,6 +826,8 @@ private:
 
     TimerStat d_boundComputationTime;
     IntStat d_boundComputations, d_boundPropagations;
+    IntStat d_impliedBoundsSingleton, d_impliedBoundsFull;
+    IntStat d_singletonsFiltered;
 
     IntStat d_unknownChecks;
     IntStat d_maxUnknownsInARow;
@@ -861,6 +882,8 @@ private:
 
     IntStat d_cutsRejectedDuringReplay;
     IntStat d_cutsRejectedDuringLemmas;
+    IntStat d_nativeGomoryCuts;
+    IntStat d_nativeGomoryCutsRejected;
 
     HistogramStat<uint32_t> d_satPivots;
     HistogramStat<uint32_t> d_unsatPivots;
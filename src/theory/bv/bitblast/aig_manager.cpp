@@ -0,0 +1,108 @@
+/*********************                                                        */
+/*! \file aig_manager.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A structurally hashed and-inverter graph with integer literals.
+ **
+ **/
+
+#include "theory/bv/bitblast/aig_manager.h"
+
+#include <utility>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+std::ostream& operator<<(std::ostream& out, const AigLit& lit)
+{
+  if (lit.isConst())
+  {
+    return out << (lit.isNegated() ? "true" : "false");
+  }
+  return out << (lit.isNegated() ? "-" : "") << "a" << lit.getNode();
+}
+
+thread_local AigManager* AigManager::s_current = nullptr;
+
+AigManager::AigManager()
+{
+  // node 0 is the constant false
+  d_child0.emplace_back(AigLit{0});
+  d_child1.emplace_back(AigLit{0});
+}
+
+AigLit AigManager::mkInput()
+{
+  uint32_t node = d_child0.size();
+  d_child0.emplace_back(AigLit{s_input});
+  d_child1.emplace_back(AigLit{s_input});
+  return AigLit{node << 1};
+}
+
+AigLit AigManager::mkAnd(AigLit a, AigLit b)
+{
+  if (b < a)
+  {
+    std::swap(a, b);
+  }
+  if (a == mkConst(false) || a == ~b)
+  {
+    return mkConst(false);
+  }
+  if (a == mkConst(true) || a == b)
+  {
+    return b;
+  }
+  uint64_t key = (static_cast<uint64_t>(a.d_lit) << 32) | b.d_lit;
+  auto it = d_strash.find(key);
+  if (it != d_strash.end())
+  {
+    return AigLit{it->second << 1};
+  }
+  uint32_t node = d_child0.size();
+  Assert(node < (1u << 31)) << "AIG exceeds the range of literals";
+  d_child0.emplace_back(a);
+  d_child1.emplace_back(b);
+  d_strash.emplace(key, node);
+  return AigLit{node << 1};
+}
+
+AigLit AigManager::mkXor(AigLit a, AigLit b)
+{
+  return mkOr(mkAnd(a, ~b), mkAnd(~a, b));
+}
+
+AigLit AigManager::mkIte(AigLit cond, AigLit a, AigLit b)
+{
+  if (a == b)
+  {
+    return a;
+  }
+  return mkOr(mkAnd(cond, a), mkAnd(~cond, b));
+}
+
+AigManager* AigManager::current()
+{
+  Assert(s_current != nullptr);
+  return s_current;
+}
+
+AigManager::Scope::Scope(AigManager* aig) : d_previous(s_current)
+{
+  s_current = aig;
+}
+
+AigManager::Scope::~Scope() { s_current = d_previous; }
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file aig_manager.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A structurally hashed and-inverter graph with integer literals.
+ **
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__AIG_MANAGER_H
+#define CVC4__THEORY__BV__BITBLAST__AIG_MANAGER_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+/**
+ * A literal of an AigManager: twice the index of a node, plus one if the
+ * node is negated. Node zero is the constant false, hence literal 0 is false
+ * and literal 1 is true.
+ */
+struct AigLit
+{
+  uint32_t d_lit = 0;
+
+  /** The index of the node of this literal */
+  uint32_t getNode() const { return d_lit >> 1; }
+  /** Whether this literal negates its node */
+  bool isNegated() const { return d_lit & 1; }
+  /** Whether this literal is the constant true or false */
+  bool isConst() const { return getNode() == 0; }
+
+  AigLit operator~() const { return AigLit{d_lit ^ 1}; }
+  bool operator==(const AigLit& other) const { return d_lit == other.d_lit; }
+  bool operator!=(const AigLit& other) const { return d_lit != other.d_lit; }
+  bool operator<(const AigLit& other) const { return d_lit < other.d_lit; }
+};
+
+/** Print an AIG literal */
+std::ostream& operator<<(std::ostream& out, const AigLit& lit);
+
+/**
+ * An and-inverter graph. Nodes are inputs or conjunctions of two literals and
+ * are identified by their index. Conjunctions are hashed structurally and
+ * simplified if a child is constant or both children share a node, so every
+ * conjunction has two non-constant children over different nodes.
+ *
+ * The children are stored in two arrays indexed by node, which keeps a node
+ * at eight bytes plus its entry in the structural hash table.
+ */
+class AigManager
+{
+ public:
+  AigManager();
+
+  /** Make the constant true or false */
+  static AigLit mkConst(bool value) { return AigLit{value ? 1u : 0u}; }
+  /** Make a fresh input */
+  AigLit mkInput();
+  /** Make the conjunction of a and b */
+  AigLit mkAnd(AigLit a, AigLit b);
+  /** Make the disjunction of a and b */
+  AigLit mkOr(AigLit a, AigLit b) { return ~mkAnd(~a, ~b); }
+  /** Make the exclusive disjunction of a and b */
+  AigLit mkXor(AigLit a, AigLit b);
+  /** Make if-then-else of cond, a and b */
+  AigLit mkIte(AigLit cond, AigLit a, AigLit b);
+
+  /** Whether the given node is an input */
+  bool isInput(uint32_t node) const { return d_child0[node].d_lit == s_input; }
+  /** The children of the given conjunction node */
+  AigLit getChild0(uint32_t node) const { return d_child0[node]; }
+  AigLit getChild1(uint32_t node) const { return d_child1[node]; }
+  /** The number of nodes, including the constant */
+  std::size_t size() const { return d_child0.size(); }
+
+  /** The manager used by the mk* functions for AigLit of bitblast_utils.h */
+  static AigManager* current();
+
+  /** Makes a manager the current one during its lifetime */
+  class Scope
+  {
+   public:
+    Scope(AigManager* aig);
+    ~Scope();
+
+   private:
+    AigManager* d_previous;
+  };
+
+ private:
+  /** The child marking an input */
+  static constexpr uint32_t s_input = UINT32_MAX;
+  /** The children by node */
+  std::vector<AigLit> d_child0;
+  std::vector<AigLit> d_child1;
+  /** Maps the pair of children of a conjunction to its node */
+  std::unordered_map<uint64_t, uint32_t> d_strash;
+  /** The current manager */
+  static thread_local AigManager* s_current;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif  //  CVC4__THEORY__BV__BITBLAST__AIG_MANAGER_H
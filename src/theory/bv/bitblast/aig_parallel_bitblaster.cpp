@@ -0,0 +1,270 @@
+/*********************                                                        */
+/*! \file aig_parallel_bitblaster.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bit-blasting of term cones into and-inverter graphs without nodes.
+ **/
+
+#include "theory/bv/bitblast/aig_parallel_bitblaster.h"
+
+#include "theory/bv/bitblast/aig_simple_bitblaster.h"
+#include "theory/bv/bitblast/bitblast_strategies_template.h"
+#include "theory/bv/bitblast/bitblast_utils.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+using Bits = std::vector<AigLit>;
+
+/** Bit-blast a * b with the selected multiplier. */
+void multiply(const Bits& a,
+              const Bits& b,
+              Bits& res,
+              const AigEncoding& encoding)
+{
+  std::vector<bool> value;
+  if (encoding.d_multCsd && getConstBits(b, value))
+  {
+    csdMultiplier(a, value, res);
+  }
+  else if (encoding.d_multCsd && getConstBits(a, value))
+  {
+    csdMultiplier(b, value, res);
+  }
+  else if (encoding.d_multMode == options::BvMultMode::WALLACE
+           || encoding.d_multMode == options::BvMultMode::DADDA)
+  {
+    columnCompressionMultiplier(
+        a, b, res, encoding.d_multMode == options::BvMultMode::DADDA);
+  }
+  else
+  {
+    shiftAddMultiplier(a, b, res);
+  }
+}
+
+/**
+ * Bit-blast the quotient and remainder of a and b with the selected divider,
+ * including the results of division by zero.
+ */
+void divide(const Bits& a,
+            const Bits& b,
+            Bits& q,
+            Bits& r,
+            const AigEncoding& encoding)
+{
+  if (encoding.d_divMode == options::BvDivMode::ITERATIVE)
+  {
+    uDivModIter(a, b, q, r);
+  }
+  else
+  {
+    uDivModRec(a, b, q, r, a.size());
+  }
+  Bits iszero;
+  for (AigLit bit : b)
+  {
+    iszero.push_back(mkNot(bit));
+  }
+  AigLit b_is_0 = mkAnd(iszero);
+  for (size_t i = 0; i < q.size(); ++i)
+  {
+    q[i] = mkIte(b_is_0, mkTrue<AigLit>(), q[i]);  // a udiv 0 is 11..11
+    r[i] = mkIte(b_is_0, a[i], r[i]);              // a urem 0 is a
+  }
+}
+
+/** The conjunction of the bitwise equivalences of a and b. */
+AigLit equal(const Bits& a, const Bits& b)
+{
+  Bits bits_eq;
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    bits_eq.push_back(mkIff(a[i], b[i]));
+  }
+  return mkAnd(bits_eq);
+}
+
+}  // namespace
+
+bool isShardKind(Kind k)
+{
+  switch (k)
+  {
+    case kind::BITVECTOR_NOT:
+    case kind::BITVECTOR_CONCAT:
+    case kind::BITVECTOR_EXTRACT:
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_XNOR:
+    case kind::BITVECTOR_COMP:
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_SUB:
+    case kind::BITVECTOR_NEG:
+    case kind::BITVECTOR_MULT:
+    case kind::BITVECTOR_UDIV:
+    case kind::BITVECTOR_UREM:
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+    case kind::EQUAL:
+    case kind::BITVECTOR_ULT:
+    case kind::BITVECTOR_ULE:
+    case kind::BITVECTOR_SLT:
+    case kind::BITVECTOR_SLE: return true;
+    default: return false;
+  }
+}
+
+void bitblastShard(AigShard& shard, const AigEncoding& encoding)
+{
+  AigManager::Scope scope(&shard.d_aig);
+  std::vector<Bits>& bits = shard.d_bits;
+  bits.resize(shard.d_instructions.size());
+
+  for (size_t i = 0, n = shard.d_instructions.size(); i < n; ++i)
+  {
+    const AigInstruction& inst = shard.d_instructions[i];
+    if (inst.d_kind == kind::UNDEFINED_KIND)
+    {
+      continue;
+    }
+    auto child = [&](size_t j) -> const Bits& {
+      return bits[inst.d_children[j]];
+    };
+    size_t numChildren = inst.d_children.size();
+    Bits& res = bits[i];
+
+    switch (inst.d_kind)
+    {
+      case kind::BITVECTOR_NOT: negateBits(child(0), res); break;
+
+      case kind::BITVECTOR_CONCAT:
+        for (size_t j = numChildren; j-- > 0;)
+        {
+          res.insert(res.end(), child(j).begin(), child(j).end());
+        }
+        break;
+
+      case kind::BITVECTOR_EXTRACT:
+        extractBits(child(0), res, inst.d_low, inst.d_high);
+        break;
+
+      case kind::BITVECTOR_AND:
+      case kind::BITVECTOR_OR:
+      case kind::BITVECTOR_XOR:
+        res = child(0);
+        for (size_t j = 1; j < numChildren; ++j)
+        {
+          for (size_t k = 0; k < res.size(); ++k)
+          {
+            res[k] = inst.d_kind == kind::BITVECTOR_AND
+                         ? mkAnd(res[k], child(j)[k])
+                         : inst.d_kind == kind::BITVECTOR_OR
+                               ? mkOr(res[k], child(j)[k])
+                               : mkXor(res[k], child(j)[k]);
+          }
+        }
+        break;
+
+      case kind::BITVECTOR_XNOR:
+        for (size_t k = 0; k < child(0).size(); ++k)
+        {
+          res.push_back(mkIff(child(0)[k], child(1)[k]));
+        }
+        break;
+
+      case kind::BITVECTOR_COMP:
+        res.push_back(equal(child(0), child(1)));
+        break;
+
+      case kind::BITVECTOR_PLUS:
+        res = child(0);
+        for (size_t j = 1; j < numChildren; ++j)
+        {
+          Bits sum;
+          rippleCarryAdder(res, child(j), sum, mkFalse<AigLit>());
+          res = sum;
+        }
+        break;
+
+      case kind::BITVECTOR_SUB:
+      {
+        // bvsub a b = adder(a, ~b, 1)
+        Bits not_b;
+        negateBits(child(1), not_b);
+        rippleCarryAdder(child(0), not_b, res, mkTrue<AigLit>());
+        break;
+      }
+
+      case kind::BITVECTOR_NEG:
+      {
+        // -a = add(~a, 0, 1)
+        Bits not_a, zero;
+        negateBits(child(0), not_a);
+        makeZero(zero, not_a.size());
+        rippleCarryAdder(not_a, zero, res, mkTrue<AigLit>());
+        break;
+      }
+
+      case kind::BITVECTOR_MULT:
+        res = child(0);
+        for (size_t j = 1; j < numChildren; ++j)
+        {
+          Bits product;
+          multiply(res, child(j), product, encoding);
+          res = product;
+        }
+        break;
+
+      case kind::BITVECTOR_UDIV:
+      case kind::BITVECTOR_UREM:
+      {
+        Bits q, r;
+        divide(child(0), child(1), q, r, encoding);
+        res = inst.d_kind == kind::BITVECTOR_UDIV ? q : r;
+        break;
+      }
+
+      case kind::BITVECTOR_ZERO_EXTEND:
+      case kind::BITVECTOR_SIGN_EXTEND:
+      {
+        res = child(0);
+        AigLit ext = inst.d_kind == kind::BITVECTOR_ZERO_EXTEND
+                         ? mkFalse<AigLit>()
+                         : res.back();
+        res.insert(res.end(), inst.d_amount, ext);
+        break;
+      }
+
+      case kind::EQUAL: res.push_back(equal(child(0), child(1))); break;
+
+      case kind::BITVECTOR_ULT:
+      case kind::BITVECTOR_ULE:
+        res.push_back(uLessThanBB(
+            child(0), child(1), inst.d_kind == kind::BITVECTOR_ULE));
+        break;
+
+      case kind::BITVECTOR_SLT:
+      case kind::BITVECTOR_SLE:
+        res.push_back(sLessThanBB(
+            child(0), child(1), inst.d_kind == kind::BITVECTOR_SLE));
+        break;
+
+      default: Unreachable() << "unsupported kind " << inst.d_kind;
+    }
+  }
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,88 @@
+/*********************                                                        */
+/*! \file aig_parallel_bitblaster.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bit-blasting of term cones into and-inverter graphs without nodes.
+ **
+ ** Nodes are reference counted without synchronization and must not be
+ ** touched by other threads. To bit-blast on several threads, the cones of
+ ** the atoms are flattened into instructions on the main thread, and every
+ ** thread bit-blasts a shard of them into its own AIG.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__AIG_PARALLEL_BITBLASTER_H
+#define CVC4__THEORY__BV__BITBLAST__AIG_PARALLEL_BITBLASTER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "expr/kind.h"
+#include "options/bv_options.h"
+#include "theory/bv/bitblast/aig_manager.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+/** The encodings selected by the options, read on the main thread. */
+struct AigEncoding
+{
+  options::BvMultMode d_multMode;
+  bool d_multCsd;
+  options::BvDivMode d_divMode;
+};
+
+/**
+ * A term or atom of a shard, whose children are instructions of the same
+ * shard that precede it. Leaves have kind UNDEFINED_KIND, their bits are
+ * given.
+ */
+struct AigInstruction
+{
+  Kind d_kind = kind::UNDEFINED_KIND;
+  std::vector<uint32_t> d_children;
+  /** The indices of extracts */
+  unsigned d_high = 0;
+  unsigned d_low = 0;
+  /** The number of bits added by extensions */
+  unsigned d_amount = 0;
+};
+
+/** A set of cones that is bit-blasted on one thread. */
+struct AigShard
+{
+  /** The instructions, children before parents */
+  std::vector<AigInstruction> d_instructions;
+  /** The bits of each instruction in d_aig, one bit for atoms */
+  std::vector<std::vector<AigLit>> d_bits;
+  /** The AIG of the shard */
+  AigManager d_aig;
+  /** The inputs of d_aig and the literals of the leaves they stand for */
+  std::vector<std::pair<uint32_t, AigLit>> d_leafInputs;
+  /** The number of instructions that are no leaves */
+  size_t d_load = 0;
+};
+
+/** Whether terms or atoms of kind `k` are supported by bitblastShard(). */
+bool isShardKind(Kind k);
+
+/**
+ * Bit-blast the instructions of `shard` that are no leaves into the AIG of
+ * the shard. Touches neither nodes nor options, hence may run on any thread.
+ */
+void bitblastShard(AigShard& shard, const AigEncoding& encoding);
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif  //  CVC4__THEORY__BV__BITBLAST__AIG_PARALLEL_BITBLASTER_H
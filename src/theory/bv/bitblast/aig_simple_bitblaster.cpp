@@ -0,0 +1,484 @@
+/*********************                                                        */
+/*! \file aig_simple_bitblaster.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bitblaster into an and-inverter graph for the bitblast BV solver.
+ **
+ **/
+
+#include "theory/bv/bitblast/aig_simple_bitblaster.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include "options/bv_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/bitblast/aig_parallel_bitblaster.h"
+#include "theory/bv/theory_bv_utils.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+template <>
+std::string toString<AigLit>(const std::vector<AigLit>& bits)
+{
+  std::ostringstream os;
+  for (int i = bits.size() - 1; i >= 0; --i)
+  {
+    os << bits[i] << (i > 0 ? " " : "");
+  }
+  return os.str();
+}
+
+BBAig::BBAig(prop::SatSolver* solver)
+    : TBitblaster<AigLit>(), d_satSolver(solver)
+{
+}
+
+void BBAig::bbAtom(TNode node)
+{
+  node = node.getKind() == kind::NOT ? node[0] : node;
+
+  if (hasBBAtom(node))
+  {
+    return;
+  }
+
+  TimerStat::CodeTimer timer(d_statistics.d_bitblastTime);
+  AigManager::Scope scope(&d_aig);
+  Node normalized = Rewriter::rewrite(node);
+  AigLit atom_bb;
+  if (normalized.getKind() == kind::CONST_BOOLEAN)
+  {
+    atom_bb = AigManager::mkConst(normalized.getConst<bool>());
+  }
+  else if (normalized.getKind() == kind::BITVECTOR_BITOF)
+  {
+    Bits bits;
+    bbTerm(normalized[0], bits);
+    atom_bb =
+        bits[normalized.getOperator().getConst<BitVectorBitOf>().d_bitIndex];
+  }
+  else
+  {
+    atom_bb = d_atomBBStrategies[normalized.getKind()](normalized, this);
+  }
+  storeBBAtom(node, atom_bb);
+  d_statistics.d_numAigNodes.maxAssign(d_aig.size());
+}
+
+void BBAig::storeBBAtom(TNode atom, AigLit atom_bb)
+{
+  d_bbAtoms.emplace(atom, atom_bb);
+}
+
+bool BBAig::hasBBAtom(TNode lit) const
+{
+  if (lit.getKind() == kind::NOT)
+  {
+    lit = lit[0];
+  }
+  return d_bbAtoms.find(lit) != d_bbAtoms.end();
+}
+
+AigLit BBAig::getBBAtom(TNode node) const
+{
+  bool negated = false;
+  if (node.getKind() == kind::NOT)
+  {
+    node = node[0];
+    negated = true;
+  }
+
+  Assert(hasBBAtom(node));
+  AigLit atom_bb = d_bbAtoms.at(node);
+  return negated ? ~atom_bb : atom_bb;
+}
+
+void BBAig::makeVariable(TNode var, Bits& bits)
+{
+  Assert(bits.size() == 0);
+  for (unsigned i = 0; i < utils::getSize(var); ++i)
+  {
+    bits.push_back(d_aig.mkInput());
+  }
+  d_variables.insert(var);
+}
+
+void BBAig::bbTerm(TNode node, Bits& bits)
+{
+  Assert(node.getType().isBitVector());
+  if (hasBBTerm(node))
+  {
+    getBBTerm(node, bits);
+    return;
+  }
+  AigManager::Scope scope(&d_aig);
+  d_termBBStrategies[node.getKind()](node, bits, this);
+  Assert(bits.size() == utils::getSize(node));
+  storeBBTerm(node, bits);
+}
+
+prop::SatLiteral BBAig::getSatLiteral(TNode atom)
+{
+  bbAtom(atom);
+  TimerStat::CodeTimer timer(d_statistics.d_cnfConversionTime);
+  return toSatLiteral(getBBAtom(atom));
+}
+
+bool BBAig::getBitValue(AigLit bit, bool& value)
+{
+  if (bit.isConst())
+  {
+    value = bit.isNegated();
+    return true;
+  }
+  if (bit.getNode() >= d_satVars.size()
+      || d_satVars[bit.getNode()] == prop::undefSatVariable)
+  {
+    return false;
+  }
+  prop::SatValue val = d_satSolver->modelValue(convertedLiteral(bit));
+  value = val == prop::SatValue::SAT_VALUE_TRUE;
+  return true;
+}
+
+void BBAig::bbAtoms(const std::vector<Node>& atoms, unsigned numThreads)
+{
+  TimerStat::CodeTimer timer(d_statistics.d_parallelBitblastTime);
+  AigManager::Scope scope(&d_aig);
+
+  // The atoms to shard and their normal forms
+  std::vector<std::pair<Node, Node>> todo;
+  std::unordered_set<TNode, TNodeHashFunction> seen;
+  for (TNode atom : atoms)
+  {
+    atom = atom.getKind() == kind::NOT ? atom[0] : atom;
+    if (hasBBAtom(atom) || !seen.insert(atom).second)
+    {
+      continue;
+    }
+    Node normalized = Rewriter::rewrite(atom);
+    if (!isShardKind(normalized.getKind())
+        || !normalized[0].getType().isBitVector())
+    {
+      bbAtom(atom);
+      continue;
+    }
+    todo.emplace_back(atom, normalized);
+  }
+  if (todo.empty())
+  {
+    return;
+  }
+
+  // Collect the cone of each atom, children before parents. Terms that are
+  // bit-blasted already or not supported are leaves and bit-blasted here.
+  // Atoms whose cones share a term are joined by union-find, a term is part
+  // of the cone of the first atom that reaches it.
+  std::vector<std::vector<Node>> cones(todo.size());
+  std::unordered_map<Node, size_t, NodeHashFunction> owner;
+  std::vector<size_t> component(todo.size());
+  std::iota(component.begin(), component.end(), 0);
+  auto find = [&component](size_t i) {
+    while (component[i] != i)
+    {
+      i = component[i] = component[component[i]];
+    }
+    return i;
+  };
+  for (size_t i = 0, size = todo.size(); i < size; ++i)
+  {
+    std::vector<std::pair<TNode, bool>> visit{{todo[i].second, false}};
+    while (!visit.empty())
+    {
+      std::pair<TNode, bool> cur = visit.back();
+      visit.pop_back();
+      if (cur.second)
+      {
+        cones[i].push_back(cur.first);
+        continue;
+      }
+      auto it = owner.find(cur.first);
+      if (it != owner.end())
+      {
+        component[find(it->second)] = find(i);
+        continue;
+      }
+      if (cur.first != todo[i].second
+          && (hasBBTerm(cur.first) || !isShardKind(cur.first.getKind())))
+      {
+        if (!hasBBTerm(cur.first))
+        {
+          Bits bits;
+          bbTerm(cur.first, bits);
+        }
+        continue;
+      }
+      owner.emplace(cur.first, i);
+      visit.emplace_back(cur.first, true);
+      for (const Node& child : cur.first)
+      {
+        visit.emplace_back(child, false);
+      }
+    }
+  }
+
+  // Distribute the components over the shards, largest first, each to the
+  // shard with the fewest terms.
+  std::unordered_map<size_t, std::vector<size_t>> components;
+  for (size_t i = 0, size = todo.size(); i < size; ++i)
+  {
+    components[find(i)].push_back(i);
+  }
+  std::vector<std::pair<size_t, size_t>> loads;
+  for (const auto& c : components)
+  {
+    size_t load = 0;
+    for (size_t i : c.second)
+    {
+      load += cones[i].size();
+    }
+    loads.emplace_back(load, c.first);
+  }
+  std::sort(loads.rbegin(), loads.rend());
+
+  size_t numShards = std::min<size_t>(std::max(numThreads, 1u), loads.size());
+  std::vector<AigShard> shards(numShards);
+  // The atoms of each shard and the node of each instruction
+  std::vector<std::vector<size_t>> shardAtoms(numShards);
+  std::vector<std::vector<Node>> shardTerms(numShards);
+  std::vector<std::unordered_map<Node, uint32_t, NodeHashFunction>> indices(
+      numShards);
+  for (const auto& l : loads)
+  {
+    size_t s = 0;
+    for (size_t j = 1; j < numShards; ++j)
+    {
+      s = shards[j].d_load < shards[s].d_load ? j : s;
+    }
+    AigShard& shard = shards[s];
+    std::unordered_map<Node, uint32_t, NodeHashFunction>& index = indices[s];
+    for (size_t i : components[l.second])
+    {
+      shardAtoms[s].push_back(i);
+      for (const Node& term : cones[i])
+      {
+        AigInstruction inst;
+        inst.d_kind = term.getKind();
+        if (inst.d_kind == kind::BITVECTOR_EXTRACT)
+        {
+          inst.d_high = utils::getExtractHigh(term);
+          inst.d_low = utils::getExtractLow(term);
+        }
+        else if (inst.d_kind == kind::BITVECTOR_ZERO_EXTEND
+                 || inst.d_kind == kind::BITVECTOR_SIGN_EXTEND)
+        {
+          inst.d_amount = utils::getSize(term) - utils::getSize(term[0]);
+        }
+        for (const Node& child : term)
+        {
+          auto it = index.find(child);
+          if (it == index.end())
+          {
+            // A leaf, whose non-constant bits are inputs of the shard.
+            Bits bits, local;
+            getBBTerm(child, bits);
+            for (AigLit bit : bits)
+            {
+              AigLit input = bit.isConst() ? bit : shard.d_aig.mkInput();
+              if (!bit.isConst())
+              {
+                shard.d_leafInputs.emplace_back(input.getNode(), bit);
+              }
+              local.push_back(input);
+            }
+            it = index.emplace(child, shard.d_instructions.size()).first;
+            shard.d_instructions.emplace_back();
+            shard.d_bits.push_back(local);
+            shardTerms[s].push_back(child);
+          }
+          inst.d_children.push_back(it->second);
+        }
+        index.emplace(term, shard.d_instructions.size());
+        shard.d_instructions.push_back(inst);
+        shard.d_bits.emplace_back();
+        shardTerms[s].push_back(term);
+        ++shard.d_load;
+      }
+    }
+  }
+
+  // Bit-blast the shards, the first one on this thread.
+  AigEncoding encoding{
+      options::bvMultMode(), options::bvMultCsd(), options::bvDivMode()};
+  std::vector<std::thread> threads;
+  for (size_t s = 1; s < numShards; ++s)
+  {
+    threads.emplace_back(
+        [&shards, &encoding, s]() { bitblastShard(shards[s], encoding); });
+  }
+  bitblastShard(shards[0], encoding);
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+
+  // Merge the AIGs of the shards into d_aig, in the order of their nodes,
+  // and store the bits of their terms and atoms.
+  for (size_t s = 0; s < numShards; ++s)
+  {
+    const AigShard& shard = shards[s];
+    std::vector<AigLit> merged(shard.d_aig.size(), AigManager::mkConst(false));
+    for (const auto& input : shard.d_leafInputs)
+    {
+      merged[input.first] = input.second;
+    }
+    auto translate = [&merged](AigLit lit) {
+      return lit.isNegated() ? ~merged[lit.getNode()] : merged[lit.getNode()];
+    };
+    for (uint32_t node = 1, size = shard.d_aig.size(); node < size; ++node)
+    {
+      if (!shard.d_aig.isInput(node))
+      {
+        merged[node] = d_aig.mkAnd(translate(shard.d_aig.getChild0(node)),
+                                   translate(shard.d_aig.getChild1(node)));
+      }
+    }
+
+    for (size_t i = 0, size = shard.d_instructions.size(); i < size; ++i)
+    {
+      TNode term = shardTerms[s][i];
+      if (shard.d_instructions[i].d_kind == kind::UNDEFINED_KIND
+          || !term.getType().isBitVector() || hasBBTerm(term))
+      {
+        continue;
+      }
+      Bits bits;
+      for (AigLit bit : shard.d_bits[i])
+      {
+        bits.push_back(translate(bit));
+      }
+      storeBBTerm(term, bits);
+    }
+    for (size_t i : shardAtoms[s])
+    {
+      uint32_t j = indices[s].at(todo[i].second);
+      storeBBAtom(todo[i].first, translate(shard.d_bits[j][0]));
+    }
+  }
+
+  d_statistics.d_numParallelAtoms += todo.size();
+  d_statistics.d_numShards += numShards;
+  d_statistics.d_numAigNodes.maxAssign(d_aig.size());
+}
+
+bool BBAig::isVariable(TNode node)
+{
+  return d_variables.find(node) != d_variables.end();
+}
+
+prop::SatLiteral BBAig::toSatLiteral(AigLit lit)
+{
+  if (lit.isConst())
+  {
+    return prop::SatLiteral(d_satSolver->trueVar(), !lit.isNegated());
+  }
+  d_satVars.resize(d_aig.size(), prop::undefSatVariable);
+
+  // Convert the cone of lit in post-order, using an explicit stack.
+  std::vector<uint32_t> visit{lit.getNode()};
+  while (!visit.empty())
+  {
+    uint32_t node = visit.back();
+    if (d_satVars[node] != prop::undefSatVariable)
+    {
+      visit.pop_back();
+      continue;
+    }
+    if (d_aig.isInput(node))
+    {
+      d_satVars[node] = d_satSolver->newVar(false, false, false);
+      visit.pop_back();
+      continue;
+    }
+    AigLit a = d_aig.getChild0(node);
+    AigLit b = d_aig.getChild1(node);
+    bool ready = true;
+    for (AigLit child : {a, b})
+    {
+      if (d_satVars[child.getNode()] == prop::undefSatVariable)
+      {
+        visit.push_back(child.getNode());
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    visit.pop_back();
+    d_satVars[node] = d_satSolver->newVar(false, false, false);
+    prop::SatLiteral out(d_satVars[node]);
+    prop::SatLiteral la = convertedLiteral(a);
+    prop::SatLiteral lb = convertedLiteral(b);
+    // out <=> (a and b)
+    prop::SatClause c0{~out, la};
+    prop::SatClause c1{~out, lb};
+    prop::SatClause c2{out, ~la, ~lb};
+    d_satSolver->addClause(c0, false);
+    d_satSolver->addClause(c1, false);
+    d_satSolver->addClause(c2, false);
+    d_statistics.d_numClauses += 3;
+  }
+  return convertedLiteral(lit);
+}
+
+prop::SatLiteral BBAig::convertedLiteral(AigLit lit) const
+{
+  Assert(!lit.isConst() && d_satVars[lit.getNode()] != prop::undefSatVariable);
+  return prop::SatLiteral(d_satVars[lit.getNode()], lit.isNegated());
+}
+
+BBAig::Statistics::Statistics()
+    : d_numAigNodes("theory::bv::BBAig::numAigNodes", 0),
+      d_numClauses("theory::bv::BBAig::numClauses", 0),
+      d_numParallelAtoms("theory::bv::BBAig::numParallelAtoms", 0),
+      d_numShards("theory::bv::BBAig::numShards", 0),
+      d_bitblastTime("theory::bv::BBAig::bitblastTime"),
+      d_parallelBitblastTime("theory::bv::BBAig::parallelBitblastTime"),
+      d_cnfConversionTime("theory::bv::BBAig::cnfConversionTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numAigNodes);
+  smtStatisticsRegistry()->registerStat(&d_numClauses);
+  smtStatisticsRegistry()->registerStat(&d_numParallelAtoms);
+  smtStatisticsRegistry()->registerStat(&d_numShards);
+  smtStatisticsRegistry()->registerStat(&d_bitblastTime);
+  smtStatisticsRegistry()->registerStat(&d_parallelBitblastTime);
+  smtStatisticsRegistry()->registerStat(&d_cnfConversionTime);
+}
+
+BBAig::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numAigNodes);
+  smtStatisticsRegistry()->unregisterStat(&d_numClauses);
+  smtStatisticsRegistry()->unregisterStat(&d_numParallelAtoms);
+  smtStatisticsRegistry()->unregisterStat(&d_numShards);
+  smtStatisticsRegistry()->unregisterStat(&d_bitblastTime);
+  smtStatisticsRegistry()->unregisterStat(&d_parallelBitblastTime);
+  smtStatisticsRegistry()->unregisterStat(&d_cnfConversionTime);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,188 @@
+/*********************                                                        */
+/*! \file aig_simple_bitblaster.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bitblaster into an and-inverter graph for the bitblast BV solver.
+ **
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST_AIG_SIMPLE_BITBLASTER_H
+#define CVC4__THEORY__BV__BITBLAST_AIG_SIMPLE_BITBLASTER_H
+
+#include "theory/bv/bitblast/aig_manager.h"
+#include "theory/bv/bitblast/bitblaster.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+template <>
+std::string toString<AigLit>(const std::vector<AigLit>& bits);
+
+template <> inline
+AigLit mkTrue<AigLit>() {
+  return AigManager::mkConst(true);
+}
+
+template <> inline
+AigLit mkFalse<AigLit>() {
+  return AigManager::mkConst(false);
+}
+
+template <> inline
+AigLit mkNot<AigLit>(AigLit a) {
+  return ~a;
+}
+
+template <> inline
+AigLit mkOr<AigLit>(AigLit a, AigLit b) {
+  return AigManager::current()->mkOr(a, b);
+}
+
+template <> inline
+AigLit mkOr<AigLit>(const std::vector<AigLit>& children) {
+  Assert(children.size());
+  AigLit result = children[0];
+  for (unsigned i = 1; i < children.size(); ++i) {
+    result = AigManager::current()->mkOr(result, children[i]);
+  }
+  return result;
+}
+
+template <> inline
+AigLit mkAnd<AigLit>(AigLit a, AigLit b) {
+  return AigManager::current()->mkAnd(a, b);
+}
+
+template <> inline
+AigLit mkAnd<AigLit>(const std::vector<AigLit>& children) {
+  Assert(children.size());
+  AigLit result = children[0];
+  for (unsigned i = 1; i < children.size(); ++i) {
+    result = AigManager::current()->mkAnd(result, children[i]);
+  }
+  return result;
+}
+
+template <> inline
+AigLit mkXor<AigLit>(AigLit a, AigLit b) {
+  return AigManager::current()->mkXor(a, b);
+}
+
+template <> inline
+AigLit mkIff<AigLit>(AigLit a, AigLit b) {
+  return ~AigManager::current()->mkXor(a, b);
+}
+
+template <> inline
+AigLit mkIte<AigLit>(AigLit cond, AigLit a, AigLit b) {
+  return AigManager::current()->mkIte(cond, a, b);
+}
+
+/**
+ * Bit-blaster that represents bits as literals of an AigManager instead of
+ * nodes, and clausifies the graph directly into a SAT solver.
+ *
+ * Bit-blasting a term creates no nodes, only entries in the AIG. A node of
+ * the AIG is converted to a SAT variable (with the three Tseitin clauses of a
+ * conjunction) the first time a literal of an asserted atom depends on it.
+ */
+class BBAig : public TBitblaster<AigLit>
+{
+  using Bits = std::vector<AigLit>;
+
+ public:
+  BBAig(prop::SatSolver* solver);
+  ~BBAig() = default;
+
+  /** Bit-blast term 'node' and return bit-blasted 'bits'. */
+  void bbTerm(TNode node, Bits& bits) override;
+  /** Bit-blast atom 'node'. */
+  void bbAtom(TNode node) override;
+  /** Get the literal of the bit-blasted atom. */
+  AigLit getBBAtom(TNode atom) const override;
+  /** Store the literal representing the bit-blasted atom. */
+  void storeBBAtom(TNode atom, AigLit atom_bb) override;
+  /** Check if atom was already bit-blasted. */
+  bool hasBBAtom(TNode atom) const override;
+  /** Create 'bits' for variable 'var'. */
+  void makeVariable(TNode var, Bits& bits) override;
+
+  /**
+   * Bit-blast the given (possibly negated) atoms on up to `numThreads`
+   * threads. The atoms are grouped into independent cones, i.e., cones that
+   * share only terms that are bit-blasted already, which are distributed
+   * over shards bit-blasted into AIGs of their own and merged into d_aig.
+   * Atoms and terms of kinds that are not supported by isShardKind() are
+   * bit-blasted on the calling thread.
+   */
+  void bbAtoms(const std::vector<Node>& atoms, unsigned numThreads);
+
+  /**
+   * Bit-blast the (possibly negated) atom and return the SAT literal that
+   * represents it, clausifying its AIG as necessary.
+   */
+  prop::SatLiteral getSatLiteral(TNode atom);
+  /**
+   * Get the value of the given bit in the current model of the SAT solver.
+   * Returns false if the bit was never clausified and is not constant.
+   */
+  bool getBitValue(AigLit bit, bool& value);
+
+  prop::SatSolver* getSatSolver() override { return d_satSolver; }
+
+  /** Checks whether node is a variable introduced via `makeVariable`.*/
+  bool isVariable(TNode node);
+
+ private:
+  Node getModelFromSatSolver(TNode a, bool fullModel) override
+  {
+    Unreachable();
+  }
+  /** Convert the given literal to a SAT literal, clausifying its cone. */
+  prop::SatLiteral toSatLiteral(AigLit lit);
+  /** The SAT literal of a literal whose node was converted already. */
+  prop::SatLiteral convertedLiteral(AigLit lit) const;
+
+  /** The and-inverter graph */
+  AigManager d_aig;
+  /** The SAT solver the graph is clausified into */
+  prop::SatSolver* d_satSolver;
+  /** The SAT variable by AIG node, if converted already */
+  std::vector<prop::SatVariable> d_satVars;
+  /** Caches variables for which we already created bits. */
+  TNodeSet d_variables;
+  /** Stores bit-blasted atoms. */
+  std::unordered_map<Node, AigLit, NodeHashFunction> d_bbAtoms;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numAigNodes;
+    IntStat d_numClauses;
+    IntStat d_numParallelAtoms;
+    IntStat d_numShards;
+    TimerStat d_bitblastTime;
+    TimerStat d_parallelBitblastTime;
+    TimerStat d_cnfConversionTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif
@@ -23,6 +23,7 @@
 #include <ostream>
 
 #include "expr/node.h"
+#include "options/bv_options.h"
 #include "theory/bv/bitblast/bitblast_utils.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
@@ -383,10 +384,31 @@ void DefaultMultBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
   for(unsigned i = 1; i < node.getNumChildren(); ++i) {
     std::vector<T> current;
     bb->bbTerm(node[i], current);
-    newres.clear(); 
-    // constructs a simple shift and add multiplier building the result
-    // in res
-    shiftAddMultiplier(res, current, newres);
+    newres.clear();
+    std::vector<bool> value;
+    if (options::bvMultCsd() && getConstBits(current, value))
+    {
+      csdMultiplier(res, value, newres);
+    }
+    else if (options::bvMultCsd() && getConstBits(res, value))
+    {
+      csdMultiplier(current, value, newres);
+    }
+    else if (options::bvMultMode() == options::BvMultMode::WALLACE
+             || options::bvMultMode() == options::BvMultMode::DADDA)
+    {
+      columnCompressionMultiplier(
+          res,
+          current,
+          newres,
+          options::bvMultMode() == options::BvMultMode::DADDA);
+    }
+    else
+    {
+      // constructs a simple shift and add multiplier building the result
+      // in res
+      shiftAddMultiplier(res, current, newres);
+    }
     res = newres;
   }
   if(Debug.isOn("bitvector-bb")) {
@@ -512,6 +534,59 @@ void uDivModRec(const std::vector<T>& a, const std::vector<T>& b, std::vector<T>
 
 }
 
+/**
+ * Restoring division that shifts one bit of `a` into the remainder per step
+ * and subtracts `b` if the remainder is not less than `b`. Unlike
+ * uDivModRec, it needs one subtractor per bit.
+ */
+template <class T>
+void uDivModIter(const std::vector<T>& a,
+                 const std::vector<T>& b,
+                 std::vector<T>& q,
+                 std::vector<T>& r)
+{
+  Assert(q.size() == 0 && r.size() == 0);
+  unsigned n = a.size();
+  makeZero(q, n);
+  makeZero(r, n);
+
+  std::vector<T> not_b;
+  negateBits(b, not_b);
+  for (unsigned i = n; i-- > 0;)
+  {
+    // r = 2 * r + a[i], where overflow is the bit shifted out of r
+    T overflow = r[n - 1];
+    lshift(r, 1);
+    r[0] = a[i];
+    std::vector<T> r_minus_b;
+    T co = rippleCarryAdder(r, not_b, r_minus_b, mkTrue<T>());
+    // r >= b if the shifted remainder overflowed or r - b does not borrow
+    T geq = mkOr(overflow, co);
+    q[i] = geq;
+    for (unsigned j = 0; j < n; ++j)
+    {
+      r[j] = mkIte(geq, r_minus_b[j], r[j]);
+    }
+  }
+}
+
+/** Bit-blast the quotient and remainder with the selected encoding. */
+template <class T>
+void uDivMod(const std::vector<T>& a,
+             const std::vector<T>& b,
+             std::vector<T>& q,
+             std::vector<T>& r)
+{
+  if (options::bvDivMode() == options::BvDivMode::ITERATIVE)
+  {
+    uDivModIter(a, b, q, r);
+  }
+  else
+  {
+    uDivModRec(a, b, q, r, a.size());
+  }
+}
+
 template <class T>
 void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
 {
@@ -524,7 +599,7 @@ void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
   bb->bbTerm(node[1], b);
 
   std::vector<T> r;
-  uDivModRec(a, b, q, r, utils::getSize(node));
+  uDivMod(a, b, q, r);
   // adding a special case for division by 0
   std::vector<T> iszero;
   for (unsigned i = 0; i < b.size(); ++i)
@@ -557,7 +632,7 @@ void DefaultUremBB(TNode node, std::vector<T>& rem, TBitblaster<T>* bb)
   bb->bbTerm(node[1], b);
 
   std::vector<T> q;
-  uDivModRec(a, b, q, rem, utils::getSize(node));
+  uDivMod(a, b, q, rem);
   // adding a special case for division by 0
   std::vector<T> iszero;
   for (unsigned i = 0; i < b.size(); ++i)
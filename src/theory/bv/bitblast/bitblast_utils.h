@@ -20,6 +20,7 @@
 #define CVC4__THEORY__BV__BITBLAST__BITBLAST_UTILS_H
 
 
+#include <algorithm>
 #include <ostream>
 #include "expr/node.h"
 
@@ -220,6 +221,203 @@ inline void shiftAddMultiplier(const std::vector<T>&a, const std::vector<T>&b, s
   }
 }
 
+/**
+ * Constructs a multiplier that reduces the columns of partial products with
+ * full and half adders until every column has at most two bits, and adds
+ * the two remaining rows with a ripple carry adder. Only the lower a.size()
+ * columns are built, as the product is truncated.
+ *
+ * @param a first factor
+ * @param b second factor
+ * @param res the product
+ * @param dadda if true, reduce columns only as far as the Dadda height
+ *        sequence 2, 3, 4, 6, 9, ... requires at each stage, otherwise
+ *        reduce as far as possible (Wallace tree)
+ */
+template <class T>
+inline void columnCompressionMultiplier(const std::vector<T>& a,
+                                        const std::vector<T>& b,
+                                        std::vector<T>& res,
+                                        bool dadda)
+{
+  Assert(a.size() == b.size() && res.size() == 0);
+  unsigned n = a.size();
+
+  std::vector<std::vector<T>> cols(n);
+  for (unsigned i = 0; i < n; ++i)
+  {
+    for (unsigned j = 0; i + j < n; ++j)
+    {
+      cols[i + j].push_back(mkAnd(a[j], b[i]));
+    }
+  }
+
+  size_t height = 0;
+  for (const std::vector<T>& col : cols)
+  {
+    height = std::max(height, col.size());
+  }
+  while (height > 2)
+  {
+    size_t target = 2;
+    while (target + target / 2 < height)
+    {
+      target += target / 2;
+    }
+    std::vector<std::vector<T>> next(n);
+    for (unsigned c = 0; c < n; ++c)
+    {
+      std::vector<T>& col = cols[c];
+      // bits of the column that enter this stage, carries of column c - 1
+      // in this stage are already in next[c]
+      size_t i = 0;
+      while (col.size() - i >= (dadda ? 2u : 3u))
+      {
+        size_t h = col.size() - i + next[c].size();
+        if (dadda && h <= target)
+        {
+          break;
+        }
+        T carry;
+        if (dadda && h == target + 1)
+        {
+          // half adder
+          next[c].push_back(mkXor(col[i], col[i + 1]));
+          carry = mkAnd(col[i], col[i + 1]);
+          i += 2;
+        }
+        else if (col.size() - i >= 3)
+        {
+          // full adder
+          T x = mkXor(col[i], col[i + 1]);
+          next[c].push_back(mkXor(x, col[i + 2]));
+          carry = mkOr(mkAnd(col[i], col[i + 1]), mkAnd(x, col[i + 2]));
+          i += 3;
+        }
+        else
+        {
+          break;
+        }
+        if (c + 1 < n)
+        {
+          next[c + 1].push_back(carry);
+        }
+      }
+      if (!dadda && col.size() - i == 2 && !next[c].empty())
+      {
+        // half adder on the remaining pair of a Wallace stage
+        next[c].push_back(mkXor(col[i], col[i + 1]));
+        if (c + 1 < n)
+        {
+          next[c + 1].push_back(mkAnd(col[i], col[i + 1]));
+        }
+        i += 2;
+      }
+      next[c].insert(next[c].end(), col.begin() + i, col.end());
+    }
+    cols.swap(next);
+    size_t previous = height;
+    height = 0;
+    for (const std::vector<T>& col : cols)
+    {
+      height = std::max(height, col.size());
+    }
+    // continue as a Wallace tree should a Dadda stage get stuck
+    dadda = dadda && height < previous;
+  }
+
+  std::vector<T> row0, row1;
+  for (unsigned c = 0; c < n; ++c)
+  {
+    row0.push_back(cols[c].size() > 0 ? cols[c][0] : mkFalse<T>());
+    row1.push_back(cols[c].size() > 1 ? cols[c][1] : mkFalse<T>());
+  }
+  rippleCarryAdder(row0, row1, res, mkFalse<T>());
+}
+
+/**
+ * Checks whether all bits are constant and stores their values in `value`.
+ */
+template <class T>
+bool inline getConstBits(const std::vector<T>& bits, std::vector<bool>& value)
+{
+  value.clear();
+  for (const T& bit : bits)
+  {
+    if (bit == mkTrue<T>())
+    {
+      value.push_back(true);
+    }
+    else if (bit == mkFalse<T>())
+    {
+      value.push_back(false);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Constructs the product of `a` with the constant `c` as a sum of shifted
+ * copies of `a`, one per nonzero digit of the canonical signed digit (CSD)
+ * recoding of `c`. A CSD recoding has no two adjacent nonzero digits, hence
+ * at most half of its digits are nonzero, and a run of ones in `c` costs one
+ * addition and one subtraction.
+ *
+ * @param a the factor
+ * @param c the bits of the constant factor, least significant first
+ * @param res the product
+ */
+template <class T>
+inline void csdMultiplier(const std::vector<T>& a,
+                          const std::vector<bool>& c,
+                          std::vector<T>& res)
+{
+  Assert(a.size() == c.size() && res.size() == 0);
+  unsigned n = a.size();
+  makeZero(res, n);
+
+  bool carry = false;
+  for (unsigned i = 0; i < n; ++i)
+  {
+    // digit i of the CSD recoding, with the carry of digits below
+    unsigned bit = c[i] + carry;
+    bool next = i + 1 < n && c[i + 1];
+    int digit = 0;
+    if (bit == 1)
+    {
+      digit = next ? -1 : 1;
+      carry = next;
+    }
+    else
+    {
+      carry = bit == 2;
+    }
+    if (digit == 0)
+    {
+      continue;
+    }
+    // res[i..n) += +-a[0..n-i), as the lower bits of a << i are zero
+    std::vector<T> hi, shifted, sum;
+    extractBits(res, hi, i, n - 1);
+    extractBits(a, shifted, 0, n - 1 - i);
+    if (digit < 0)
+    {
+      std::vector<T> negated;
+      negateBits(shifted, negated);
+      rippleCarryAdder(hi, negated, sum, mkTrue<T>());
+    }
+    else
+    {
+      rippleCarryAdder(hi, shifted, sum, mkFalse<T>());
+    }
+    std::copy(sum.begin(), sum.end(), res.begin() + i);
+  }
+}
+
 template <class T>
 T inline uLessThanBB(const std::vector<T>&a, const std::vector<T>& b, bool orEqual) {
   Assert(a.size() && b.size());
@@ -0,0 +1,471 @@
+/*********************                                                        */
+/*! \file bv_linear_solver.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Gaussian elimination modulo 2^k over asserted bit-vector facts.
+ **/
+
+#include "theory/bv/bv_linear_solver.h"
+
+#include <algorithm>
+
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/rewriter.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/** The value of bit-vector constant `node` of width at most 64. */
+uint64_t getValue(TNode node)
+{
+  return node.getConst<BitVector>().getValue().getUnsignedLong();
+}
+
+/** The number of trailing zeros of non-zero `x`. */
+unsigned trailingZeros(uint64_t x)
+{
+  Assert(x != 0);
+  unsigned res = 0;
+  for (; (x & 1) == 0; x >>= 1)
+  {
+    ++res;
+  }
+  return res;
+}
+
+/** The inverse of odd `x` modulo 2^64. */
+uint64_t inverse(uint64_t x)
+{
+  Assert(x & 1);
+  /* x is its own inverse modulo 8, and every Newton step doubles the number
+   * of correct bits. */
+  uint64_t res = x;
+  for (size_t i = 0; i < 5; ++i)
+  {
+    res *= 2 - x * res;
+  }
+  return res;
+}
+
+}  // namespace
+
+BVLinearSolver::BVLinearSolver() : d_reasonWords(0) {}
+
+bool BVLinearSolver::check(const std::vector<Node>& facts)
+{
+  TimerStat::CodeTimer timer(d_statistics.d_solveTime);
+  ++d_statistics.d_numChecks;
+  d_facts = facts;
+  d_factSet.clear();
+  d_factSet.insert(facts.begin(), facts.end());
+  d_reasonWords = (facts.size() + 63) / 64;
+  d_conflict.clear();
+  d_propagations.clear();
+
+  std::map<unsigned, System> systems;
+  for (size_t i = 0, size = facts.size(); i < size; ++i)
+  {
+    bool pol = facts[i].getKind() != NOT;
+    TNode atom = pol ? facts[i] : facts[i][0];
+    if (atom.getKind() != EQUAL || !atom[0].getType().isBitVector())
+    {
+      continue;
+    }
+    unsigned width = utils::getSize(atom[0]);
+    if (width > 64)
+    {
+      continue;
+    }
+    auto it = systems.find(width);
+    if (it == systems.end())
+    {
+      it = systems.emplace(width, System()).first;
+      it->second.d_size = width;
+      it->second.d_mask =
+          width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    }
+    System& system = it->second;
+
+    Linear diff = linearize(system, atom[0]);
+    const Linear& rhs = linearize(system, atom[1]);
+    diff.d_constant = (diff.d_constant - rhs.d_constant) & system.d_mask;
+    for (const auto& p : rhs.d_coeffs)
+    {
+      uint64_t& c = diff.d_coeffs[p.first];
+      c = (c - p.second) & system.d_mask;
+      if (c == 0)
+      {
+        diff.d_coeffs.erase(p.first);
+      }
+    }
+    if (pol)
+    {
+      system.d_equalities.emplace_back(diff, i);
+    }
+    else
+    {
+      system.d_disequalities.emplace_back(diff, i);
+    }
+  }
+
+  for (const auto& p : systems)
+  {
+    if (!p.second.d_equalities.empty() && !solve(p.second))
+    {
+      ++d_statistics.d_numConflicts;
+      return false;
+    }
+  }
+  d_statistics.d_numPropagations += d_propagations.size();
+  return true;
+}
+
+const BVLinearSolver::Linear& BVLinearSolver::linearize(System& system,
+                                                        TNode term)
+{
+  auto it = system.d_linear.find(term);
+  if (it != system.d_linear.end())
+  {
+    return it->second;
+  }
+
+  uint64_t mask = system.d_mask;
+  Linear res;
+  /* Add `factor` times the linear form of `child` to `res`. */
+  auto add = [&](TNode child, uint64_t factor) {
+    const Linear& lin = linearize(system, child);
+    res.d_constant = (res.d_constant + factor * lin.d_constant) & mask;
+    for (const auto& p : lin.d_coeffs)
+    {
+      uint64_t& c = res.d_coeffs[p.first];
+      c = (c + factor * p.second) & mask;
+      if (c == 0)
+      {
+        res.d_coeffs.erase(p.first);
+      }
+    }
+  };
+
+  bool isUnknown = false;
+  switch (term.getKind())
+  {
+    case CONST_BITVECTOR: res.d_constant = getValue(term); break;
+
+    case BITVECTOR_PLUS:
+      for (TNode child : term)
+      {
+        add(child, 1);
+      }
+      break;
+
+    /* The mask is -1 modulo 2^k. */
+    case BITVECTOR_SUB:
+      add(term[0], 1);
+      add(term[1], mask);
+      break;
+
+    case BITVECTOR_NEG: add(term[0], mask); break;
+
+    /* ~a = -a - 1 */
+    case BITVECTOR_NOT:
+      add(term[0], mask);
+      res.d_constant = (res.d_constant + mask) & mask;
+      break;
+
+    case BITVECTOR_MULT:
+    {
+      uint64_t factor = 1;
+      std::vector<TNode> operands;
+      for (TNode child : term)
+      {
+        if (child.isConst())
+        {
+          factor *= getValue(child);
+        }
+        else
+        {
+          operands.push_back(child);
+        }
+      }
+      if (operands.empty())
+      {
+        res.d_constant = factor & mask;
+      }
+      else if (operands.size() == 1)
+      {
+        add(operands[0], factor & mask);
+      }
+      else
+      {
+        isUnknown = true;
+      }
+      break;
+    }
+
+    case BITVECTOR_SHL:
+      if (term[1].isConst())
+      {
+        /* Shifting by the width or more yields zero. */
+        uint64_t shift = getValue(term[1]);
+        if (shift < system.d_size)
+        {
+          add(term[0], (uint64_t(1) << shift) & mask);
+        }
+      }
+      else
+      {
+        isUnknown = true;
+      }
+      break;
+
+    default: isUnknown = true;
+  }
+
+  if (isUnknown)
+  {
+    auto iit = system.d_unknownIndex.find(term);
+    if (iit == system.d_unknownIndex.end())
+    {
+      iit = system.d_unknownIndex.emplace(term, system.d_unknowns.size())
+                .first;
+      system.d_unknowns.push_back(term);
+    }
+    res.d_coeffs[iit->second] = 1;
+  }
+  return system.d_linear.emplace(term, res).first->second;
+}
+
+void BVLinearSolver::addRow(const System& system,
+                            const Linear& lin,
+                            size_t fact,
+                            std::vector<Row>& rows) const
+{
+  Row row;
+  row.d_coeffs.assign(system.d_unknowns.size(), 0);
+  for (const auto& p : lin.d_coeffs)
+  {
+    row.d_coeffs[p.first] = p.second;
+  }
+  row.d_rhs = (0 - lin.d_constant) & system.d_mask;
+  row.d_reasons.assign(d_reasonWords, 0);
+  row.d_reasons[fact / 64] |= uint64_t(1) << (fact % 64);
+  rows.push_back(std::move(row));
+}
+
+bool BVLinearSolver::solve(const System& system)
+{
+  uint64_t mask = system.d_mask;
+  size_t numUnknowns = system.d_unknowns.size();
+
+  std::vector<Row> rows;
+  for (const auto& eq : system.d_equalities)
+  {
+    addRow(system, eq.first, eq.second, rows);
+  }
+
+  struct Pivot
+  {
+    size_t d_row;
+    size_t d_unknown;
+    unsigned d_shift;
+  };
+  std::vector<Pivot> pivots;
+
+  /* The rows that are not eliminated yet, which are zero in the columns of
+   * all pivots. */
+  std::vector<size_t> pending(rows.size());
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    pending[i] = i;
+  }
+
+  while (true)
+  {
+    /* Select the coefficient with the fewest trailing zeros. */
+    size_t best = pending.size();
+    size_t col = 0;
+    unsigned shift = system.d_size;
+    for (size_t i = 0; i < pending.size() && shift > 0; ++i)
+    {
+      const std::vector<uint64_t>& coeffs = rows[pending[i]].d_coeffs;
+      for (size_t j = 0; j < numUnknowns && shift > 0; ++j)
+      {
+        if (coeffs[j] != 0 && trailingZeros(coeffs[j]) < shift)
+        {
+          best = i;
+          col = j;
+          shift = trailingZeros(coeffs[j]);
+        }
+      }
+    }
+
+    if (best == pending.size())
+    {
+      /* All remaining rows are 0 = rhs. */
+      for (size_t i : pending)
+      {
+        if (rows[i].d_rhs != 0)
+        {
+          d_conflict = getReasons(rows[i]);
+          return false;
+        }
+      }
+      break;
+    }
+
+    size_t r = pending[best];
+    pending[best] = pending.back();
+    pending.pop_back();
+
+    /* Scale the pivot to 2^shift and eliminate its column from the pending
+     * rows, whose coefficients there are multiples of 2^shift. */
+    uint64_t inv = inverse(rows[r].d_coeffs[col] >> shift) & mask;
+    for (uint64_t& c : rows[r].d_coeffs)
+    {
+      c = (c * inv) & mask;
+    }
+    rows[r].d_rhs = (rows[r].d_rhs * inv) & mask;
+    for (size_t i : pending)
+    {
+      uint64_t c = rows[i].d_coeffs[col];
+      if (c != 0)
+      {
+        subtract(rows[i], rows[r], c >> shift, mask);
+      }
+    }
+    pivots.push_back({r, col, shift});
+
+    /* All coefficients of the pivot row are multiples of 2^shift, since the
+     * pivot has the fewest trailing zeros, so its rhs must be one too. */
+    if (shift > 0 && (rows[r].d_rhs & ((uint64_t(1) << shift) - 1)) != 0)
+    {
+      d_conflict = getReasons(rows[r]);
+      return false;
+    }
+  }
+
+  /* Eliminate the columns of later pivots from the rows of earlier ones
+   * where the coefficients allow it. */
+  for (size_t p = pivots.size(); p-- > 0;)
+  {
+    const Pivot& pivot = pivots[p];
+    for (size_t q = 0; q < p; ++q)
+    {
+      Row& row = rows[pivots[q].d_row];
+      uint64_t c = row.d_coeffs[pivot.d_unknown];
+      if (c != 0 && trailingZeros(c) >= pivot.d_shift)
+      {
+        subtract(row, rows[pivot.d_row], c >> pivot.d_shift, mask);
+      }
+    }
+  }
+
+  /* A disequality conflicts if the equalities reduce it to 0 != 0. */
+  for (const auto& diseq : system.d_disequalities)
+  {
+    std::vector<Row> reduced;
+    addRow(system, diseq.first, diseq.second, reduced);
+    Row& row = reduced.back();
+    for (const Pivot& pivot : pivots)
+    {
+      uint64_t c = row.d_coeffs[pivot.d_unknown];
+      if (c != 0 && trailingZeros(c) >= pivot.d_shift)
+      {
+        subtract(row, rows[pivot.d_row], c >> pivot.d_shift, mask);
+      }
+    }
+    if (row.d_rhs == 0
+        && std::all_of(row.d_coeffs.begin(),
+                       row.d_coeffs.end(),
+                       [](uint64_t c) { return c == 0; }))
+    {
+      d_conflict = getReasons(row);
+      return false;
+    }
+  }
+
+  /* Rows with a single unknown with coefficient one determine its value. */
+  for (const Pivot& pivot : pivots)
+  {
+    const Row& row = rows[pivot.d_row];
+    if (pivot.d_shift > 0
+        || std::count(row.d_coeffs.begin(), row.d_coeffs.end(), 0)
+               != static_cast<std::ptrdiff_t>(numUnknowns - 1))
+    {
+      continue;
+    }
+    Node eq = Rewriter::rewrite(system.d_unknowns[pivot.d_unknown].eqNode(
+        utils::mkConst(BitVector(system.d_size, row.d_rhs))));
+    if (eq.getKind() != EQUAL || d_factSet.find(eq) != d_factSet.end())
+    {
+      continue;
+    }
+    d_propagations.emplace_back(eq, getReasons(row));
+  }
+  return true;
+}
+
+void BVLinearSolver::subtract(Row& dst,
+                              const Row& src,
+                              uint64_t factor,
+                              uint64_t mask)
+{
+  for (size_t j = 0, size = dst.d_coeffs.size(); j < size; ++j)
+  {
+    dst.d_coeffs[j] = (dst.d_coeffs[j] - factor * src.d_coeffs[j]) & mask;
+  }
+  dst.d_rhs = (dst.d_rhs - factor * src.d_rhs) & mask;
+  for (size_t w = 0, size = dst.d_reasons.size(); w < size; ++w)
+  {
+    dst.d_reasons[w] |= src.d_reasons[w];
+  }
+}
+
+std::vector<Node> BVLinearSolver::getReasons(const Row& row) const
+{
+  std::vector<Node> res;
+  for (size_t i = 0, size = d_facts.size(); i < size; ++i)
+  {
+    if (row.d_reasons[i / 64] & (uint64_t(1) << (i % 64)))
+    {
+      res.push_back(d_facts[i]);
+    }
+  }
+  return res;
+}
+
+BVLinearSolver::Statistics::Statistics()
+    : d_numChecks("theory::bv::BVLinearSolver::numChecks", 0),
+      d_numConflicts("theory::bv::BVLinearSolver::numConflicts", 0),
+      d_numPropagations("theory::bv::BVLinearSolver::numPropagations", 0),
+      d_solveTime("theory::bv::BVLinearSolver::solveTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numChecks);
+  smtStatisticsRegistry()->registerStat(&d_numConflicts);
+  smtStatisticsRegistry()->registerStat(&d_numPropagations);
+  smtStatisticsRegistry()->registerStat(&d_solveTime);
+}
+
+BVLinearSolver::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numChecks);
+  smtStatisticsRegistry()->unregisterStat(&d_numConflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_numPropagations);
+  smtStatisticsRegistry()->unregisterStat(&d_solveTime);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
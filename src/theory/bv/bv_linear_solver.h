@@ -0,0 +1,163 @@
+/*********************                                                        */
+/*! \file bv_linear_solver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Gaussian elimination modulo 2^k over asserted bit-vector facts.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_LINEAR_SOLVER_H
+#define CVC4__THEORY__BV__BV_LINEAR_SOLVER_H
+
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+/**
+ * Solver for the linear equalities and disequalities among a set of
+ * bit-vector facts of width at most 64.
+ *
+ * Terms built from bvadd, bvsub, bvneg, bvnot, and multiplications and left
+ * shifts by constants are linear combinations of their maximal other
+ * subterms, which are treated as unknowns. The equalities of each width k
+ * form a system modulo 2^k, which is solved by Gaussian elimination with
+ * machine words as coefficients.
+ *
+ * Since 2^k is no prime, the pivot of each step is the coefficient with the
+ * fewest trailing zeros, i.e., 2^v times an odd number. Its row is scaled by
+ * the inverse of the odd part, which makes every other coefficient of the
+ * pivot column a multiple of the pivot. All coefficients of the pivot row are
+ * multiples of 2^v, so the system is inconsistent unless its rhs is one too.
+ *
+ * Every row carries the set of facts it was derived from, which explains
+ * conflicts and implied values.
+ */
+class BVLinearSolver
+{
+ public:
+  BVLinearSolver();
+
+  /**
+   * Solve the linear (dis)equalities in `facts`, other facts are ignored.
+   * Returns false if a subset of them is unsatisfiable, which is then
+   * available via getConflict().
+   */
+  bool check(const std::vector<Node>& facts);
+
+  /** Get the unsatisfiable facts found by the last call to check(). */
+  const std::vector<Node>& getConflict() const { return d_conflict; }
+
+  /**
+   * Get the equalities (= t c) with constant c implied by the facts of the
+   * last call to check(), together with the facts they are derived from.
+   * Equalities that are facts themselves are omitted.
+   */
+  const std::vector<std::pair<Node, std::vector<Node>>>& getPropagations()
+      const
+  {
+    return d_propagations;
+  }
+
+ private:
+  /** A linear combination of the unknowns of a system plus a constant. */
+  struct Linear
+  {
+    /** The non-zero coefficients, by the index of their unknown */
+    std::map<size_t, uint64_t> d_coeffs;
+    uint64_t d_constant = 0;
+  };
+
+  /** A row of a system, sum of coefficients times unknowns = rhs. */
+  struct Row
+  {
+    std::vector<uint64_t> d_coeffs;
+    uint64_t d_rhs;
+    /** The indices of the facts the row is derived from, as bit set */
+    std::vector<uint64_t> d_reasons;
+  };
+
+  /** The (dis)equalities of one width. */
+  struct System
+  {
+    unsigned d_size;
+    uint64_t d_mask;
+    /** The unknowns */
+    std::vector<Node> d_unknowns;
+    std::unordered_map<Node, size_t, NodeHashFunction> d_unknownIndex;
+    /** The linear forms of the terms, cached */
+    std::unordered_map<Node, Linear, NodeHashFunction> d_linear;
+    /** The left-hand sides minus the right-hand sides, with their fact */
+    std::vector<std::pair<Linear, size_t>> d_equalities;
+    std::vector<std::pair<Linear, size_t>> d_disequalities;
+  };
+
+  /** The linear form of bit-vector `term` in `system`. */
+  const Linear& linearize(System& system, TNode term);
+
+  /** Add the row of `lin` = 0 with reason `fact` to `rows`. */
+  void addRow(const System& system,
+              const Linear& lin,
+              size_t fact,
+              std::vector<Row>& rows) const;
+
+  /**
+   * Solve `system`, recording conflicts and propagations. Returns false if
+   * it is unsatisfiable.
+   */
+  bool solve(const System& system);
+
+  /** Row `dst` minus `factor` times row `src`, modulo 2^k. */
+  static void subtract(Row& dst,
+                       const Row& src,
+                       uint64_t factor,
+                       uint64_t mask);
+
+  /** The facts the reasons of `row` stand for. */
+  std::vector<Node> getReasons(const Row& row) const;
+
+  /** The facts of the current call to check() */
+  std::vector<Node> d_facts;
+  std::unordered_set<Node, NodeHashFunction> d_factSet;
+  /** The number of words of the reason sets of the current call */
+  size_t d_reasonWords;
+
+  /** The conflict of the last call to check() */
+  std::vector<Node> d_conflict;
+  /** The propagations of the last call to check() */
+  std::vector<std::pair<Node, std::vector<Node>>> d_propagations;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numChecks;
+    IntStat d_numConflicts;
+    IntStat d_numPropagations;
+    TimerStat d_solveTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif
@@ -0,0 +1,644 @@
+/*********************                                                        */
+/*! \file bv_local_search.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Propagation-based local search over bit-vector values.
+ **/
+
+#include "theory/bv/bv_local_search.h"
+
+#include <set>
+
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/quantifiers/bv_inverter_utils.h"
+#include "theory/rewriter.h"
+#include "theory/theory.h"
+#include "util/random.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+BVLocalSearch::BVLocalSearch() {}
+
+bool BVLocalSearch::check(const std::vector<Node>& facts, uint64_t maxMoves)
+{
+  TimerStat::CodeTimer timer(d_statistics.d_searchTime);
+  ++d_statistics.d_numChecks;
+  if (!buildDag(facts))
+  {
+    return false;
+  }
+
+  std::vector<size_t> unsat;
+  for (uint64_t moves = 0;; ++moves)
+  {
+    unsat.clear();
+    for (size_t i = 0, size = d_roots.size(); i < size; ++i)
+    {
+      if (d_values[d_roots[i].first].isBitSet(0) != d_roots[i].second)
+      {
+        unsat.push_back(i);
+      }
+    }
+    if (unsat.empty())
+    {
+      break;
+    }
+    if (moves == maxMoves)
+    {
+      Debug("bv-local-search") << "giving up after " << moves << " moves, "
+                               << unsat.size() << " facts unsatisfied"
+                               << std::endl;
+      return false;
+    }
+    move(unsat[Random::getRandom().pick(0, unsat.size() - 1)]);
+    ++d_statistics.d_numMoves;
+  }
+
+  NodeManager* nm = NodeManager::currentNM();
+  d_model.clear();
+  for (size_t i = 0, size = d_terms.size(); i < size; ++i)
+  {
+    if (d_isLeaf[i])
+    {
+      d_model.emplace(d_terms[i], nm->mkConst(d_values[i]));
+    }
+  }
+  ++d_statistics.d_numSat;
+  return true;
+}
+
+Node BVLocalSearch::getValue(TNode node) const
+{
+  auto it = d_model.find(node);
+  return it == d_model.end() ? Node() : it->second;
+}
+
+bool BVLocalSearch::buildDag(const std::vector<Node>& facts)
+{
+  d_terms.clear();
+  d_index.clear();
+  d_children.clear();
+  d_parents.clear();
+  d_isLeaf.clear();
+  d_values.clear();
+  d_roots.clear();
+
+  for (const Node& fact : facts)
+  {
+    bool pol = fact.getKind() != NOT;
+    size_t i = addTerm(pol ? fact : fact[0]);
+    if (i == s_none)
+    {
+      Debug("bv-local-search") << "unsupported fact " << fact << std::endl;
+      return false;
+    }
+    d_roots.emplace_back(i, pol);
+  }
+  return true;
+}
+
+size_t BVLocalSearch::addTerm(TNode node)
+{
+  std::vector<TNode> visit{node};
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (d_index.find(cur) != d_index.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+
+    bool leaf = cur.getType().isBitVector()
+                && (cur.isConst() || Theory::isLeafOf(cur, THEORY_BV));
+    if (!leaf)
+    {
+      if (!isSupported(cur))
+      {
+        return s_none;
+      }
+      bool ready = true;
+      for (TNode child : cur)
+      {
+        if (d_index.find(child) == d_index.end())
+        {
+          visit.push_back(child);
+          ready = false;
+        }
+      }
+      if (!ready)
+      {
+        continue;
+      }
+    }
+    visit.pop_back();
+
+    size_t i = d_terms.size();
+    d_terms.push_back(cur);
+    d_index.emplace(cur, i);
+    d_children.emplace_back();
+    d_parents.emplace_back();
+    d_isLeaf.push_back(leaf && !cur.isConst());
+    if (!leaf)
+    {
+      for (TNode child : cur)
+      {
+        size_t c = d_index[child];
+        d_children[i].push_back(c);
+        d_parents[c].push_back(i);
+      }
+      d_values.push_back(evaluate(i));
+    }
+    else if (cur.isConst())
+    {
+      d_values.push_back(cur.getConst<BitVector>());
+    }
+    else
+    {
+      auto it = d_assignment.find(cur);
+      d_values.push_back(it != d_assignment.end()
+                             ? it->second
+                             : BitVector::mkZero(utils::getSize(cur)));
+    }
+  }
+  return d_index[node];
+}
+
+bool BVLocalSearch::isSupported(TNode node)
+{
+  switch (node.getKind())
+  {
+    case EQUAL: return node[0].getType().isBitVector();
+    case BITVECTOR_ULT:
+    case BITVECTOR_ULE:
+    case BITVECTOR_SLT:
+    case BITVECTOR_SLE:
+    case BITVECTOR_BITOF:
+    case BITVECTOR_NOT:
+    case BITVECTOR_NEG:
+    case BITVECTOR_PLUS:
+    case BITVECTOR_SUB:
+    case BITVECTOR_MULT:
+    case BITVECTOR_AND:
+    case BITVECTOR_OR:
+    case BITVECTOR_XOR:
+    case BITVECTOR_CONCAT:
+    case BITVECTOR_EXTRACT:
+    case BITVECTOR_ZERO_EXTEND:
+    case BITVECTOR_SIGN_EXTEND:
+    case BITVECTOR_UDIV:
+    case BITVECTOR_UREM:
+    case BITVECTOR_SHL:
+    case BITVECTOR_LSHR:
+    case BITVECTOR_ASHR:
+    case BITVECTOR_ITE: return true;
+    default: return false;
+  }
+}
+
+BitVector BVLocalSearch::evaluate(size_t i,
+                                  size_t j,
+                                  const BitVector& x) const
+{
+  TNode node = d_terms[i];
+  const std::vector<size_t>& children = d_children[i];
+  auto value = [&](size_t k) -> const BitVector& {
+    return k == j ? x : d_values[children[k]];
+  };
+  auto mkBool = [](bool b) { return BitVector(1, b ? 1u : 0u); };
+
+  switch (node.getKind())
+  {
+    case EQUAL: return mkBool(value(0) == value(1));
+    case BITVECTOR_ULT: return mkBool(value(0).unsignedLessThan(value(1)));
+    case BITVECTOR_ULE: return mkBool(value(0).unsignedLessThanEq(value(1)));
+    case BITVECTOR_SLT: return mkBool(value(0).signedLessThan(value(1)));
+    case BITVECTOR_SLE: return mkBool(value(0).signedLessThanEq(value(1)));
+    case BITVECTOR_BITOF:
+      return mkBool(value(0).isBitSet(
+          node.getOperator().getConst<BitVectorBitOf>().d_bitIndex));
+    case BITVECTOR_NOT: return ~value(0);
+    case BITVECTOR_NEG: return -value(0);
+    case BITVECTOR_SUB: return value(0) - value(1);
+    case BITVECTOR_EXTRACT:
+      return value(0).extract(utils::getExtractHigh(node),
+                              utils::getExtractLow(node));
+    case BITVECTOR_ZERO_EXTEND:
+      return value(0).zeroExtend(
+          node.getOperator().getConst<BitVectorZeroExtend>().d_zeroExtendAmount);
+    case BITVECTOR_SIGN_EXTEND:
+      return value(0).signExtend(
+          node.getOperator().getConst<BitVectorSignExtend>().d_signExtendAmount);
+    case BITVECTOR_UDIV: return value(0).unsignedDivTotal(value(1));
+    case BITVECTOR_UREM: return value(0).unsignedRemTotal(value(1));
+    case BITVECTOR_SHL: return value(0).leftShift(value(1));
+    case BITVECTOR_LSHR: return value(0).logicalRightShift(value(1));
+    case BITVECTOR_ASHR: return value(0).arithRightShift(value(1));
+    case BITVECTOR_ITE: return value(0).isBitSet(0) ? value(1) : value(2);
+    default: break;
+  }
+
+  /* n-ary operators */
+  BitVector res = value(0);
+  for (size_t k = 1, size = children.size(); k < size; ++k)
+  {
+    switch (node.getKind())
+    {
+      case BITVECTOR_PLUS: res = res + value(k); break;
+      case BITVECTOR_MULT: res = res * value(k); break;
+      case BITVECTOR_AND: res = res & value(k); break;
+      case BITVECTOR_OR: res = res | value(k); break;
+      case BITVECTOR_XOR: res = res ^ value(k); break;
+      case BITVECTOR_CONCAT: res = res.concat(value(k)); break;
+      default: Unreachable() << "unsupported operator " << node.getKind();
+    }
+  }
+  return res;
+}
+
+void BVLocalSearch::assign(size_t i, const BitVector& value)
+{
+  Assert(d_isLeaf[i]);
+  d_values[i] = value;
+  d_assignment[d_terms[i]] = value;
+
+  /* Parents have larger indices than their children, hence updating in
+   * increasing order of indices evaluates every term at most once. */
+  std::set<size_t> update(d_parents[i].begin(), d_parents[i].end());
+  while (!update.empty())
+  {
+    size_t k = *update.begin();
+    update.erase(update.begin());
+    BitVector v = evaluate(k);
+    if (v != d_values[k])
+    {
+      d_values[k] = v;
+      update.insert(d_parents[k].begin(), d_parents[k].end());
+    }
+  }
+}
+
+void BVLocalSearch::move(size_t root)
+{
+  Random& rnd = Random::getRandom();
+  size_t cur = d_roots[root].first;
+  BitVector t(1, d_roots[root].second ? 1u : 0u);
+
+  std::vector<size_t> candidates;
+  while (!d_isLeaf[cur])
+  {
+    const std::vector<size_t>& children = d_children[cur];
+    bool isIte = d_terms[cur].getKind() == BITVECTOR_ITE;
+    candidates.clear();
+    for (size_t j = 0, size = children.size(); j < size; ++j)
+    {
+      if (d_terms[children[j]].isConst())
+      {
+        continue;
+      }
+      /* Only the selected branch of an ite can change its value. */
+      if (isIte && j > 0 && d_values[children[0]].isBitSet(0) != (j == 1))
+      {
+        continue;
+      }
+      candidates.push_back(j);
+    }
+    if (candidates.empty())
+    {
+      return;
+    }
+
+    size_t j = candidates[rnd.pick(0, candidates.size() - 1)];
+    BitVector x;
+    if (inverseValue(cur, j, t, x))
+    {
+      ++d_statistics.d_numInverse;
+    }
+    else
+    {
+      x = randomValue(d_values[children[j]].getSize());
+    }
+    t = x;
+    cur = children[j];
+  }
+  assign(cur, t);
+}
+
+bool BVLocalSearch::inverseValue(size_t i,
+                                 size_t j,
+                                 const BitVector& t,
+                                 BitVector& x)
+{
+  TNode node = d_terms[i];
+  Kind k = node.getKind();
+  const std::vector<size_t>& children = d_children[i];
+  const BitVector& cur = d_values[children[j]];
+  unsigned w = cur.getSize();
+  BitVector zero = BitVector::mkZero(w);
+  BitVector one = BitVector::mkOne(w);
+  BitVector ones = BitVector::mkOnes(w);
+  /* The value of the other operand of binary operators. For n-ary operators,
+   * the value of the other operands is obtained by evaluating the operator
+   * with the neutral element for child j. */
+  BitVector s = children.size() == 2 ? d_values[children[1 - j]] : BitVector();
+
+  switch (k)
+  {
+    case EQUAL:
+    {
+      if (t.isBitSet(0))
+      {
+        x = s;
+      }
+      else
+      {
+        BitVector r = randomValue(w);
+        x = s ^ (r == zero ? one : r);
+      }
+      break;
+    }
+    case BITVECTOR_ULT:
+    case BITVECTOR_ULE:
+    case BITVECTOR_SLT:
+    case BITVECTOR_SLE:
+    {
+      if ((k == BITVECTOR_ULT || k == BITVECTOR_SLT)
+          && !isInvertible(i, j, s, t))
+      {
+        return false;
+      }
+      bool b = t.isBitSet(0);
+      bool strict = (k == BITVECTOR_ULT || k == BITVECTOR_SLT) == b;
+      bool below = (j == 0) == b;
+      /* Signed comparison is unsigned comparison with flipped sign bits. */
+      BitVector flip = (k == BITVECTOR_SLT || k == BITVECTOR_SLE)
+                           ? BitVector::mkMinSigned(w)
+                           : zero;
+      BitVector bound = s ^ flip;
+      BitVector lo = zero;
+      BitVector hi = ones;
+      if (below)
+      {
+        if (strict && bound == zero) return false;
+        hi = strict ? bound - one : bound;
+      }
+      else
+      {
+        if (strict && bound == ones) return false;
+        lo = strict ? bound + one : bound;
+      }
+      x = randomBetween(lo, hi) ^ flip;
+      break;
+    }
+    case BITVECTOR_BITOF:
+      x = cur.setBit(node.getOperator().getConst<BitVectorBitOf>().d_bitIndex,
+                     t.isBitSet(0));
+      break;
+    case BITVECTOR_NOT: x = ~t; break;
+    case BITVECTOR_NEG: x = -t; break;
+    case BITVECTOR_SUB: x = j == 0 ? t + s : s - t; break;
+    case BITVECTOR_PLUS: x = t - evaluate(i, j, zero); break;
+    case BITVECTOR_XOR: x = t ^ evaluate(i, j, zero); break;
+    case BITVECTOR_AND:
+    {
+      s = evaluate(i, j, ones);
+      if (!isInvertible(i, j, s, t)) return false;
+      x = t | (randomValue(w) & ~s);
+      break;
+    }
+    case BITVECTOR_OR:
+    {
+      s = evaluate(i, j, zero);
+      if (!isInvertible(i, j, s, t)) return false;
+      x = (t & ~s) | (randomValue(w) & s);
+      break;
+    }
+    case BITVECTOR_MULT:
+    {
+      s = evaluate(i, j, one);
+      if (!isInvertible(i, j, s, t)) return false;
+      if (s == zero)
+      {
+        x = randomValue(w);
+        break;
+      }
+      /* With s = 2^tz * odd, x = (t >> tz) * odd^-1 on the low w - tz bits. */
+      unsigned tz = 0;
+      while (!s.isBitSet(tz)) ++tz;
+      BitVector shift(w, tz);
+      BitVector odd = s.logicalRightShift(shift);
+      BitVector inv = odd;
+      BitVector two(w, 2u);
+      for (unsigned bits = 3; bits < w; bits *= 2)
+      {
+        inv = inv * (two - odd * inv);
+      }
+      BitVector low = ones.logicalRightShift(shift);
+      x = ((t.logicalRightShift(shift) * inv) & low) | (randomValue(w) & ~low);
+      break;
+    }
+    case BITVECTOR_CONCAT:
+    {
+      unsigned low = 0;
+      for (size_t c = j + 1, size = children.size(); c < size; ++c)
+      {
+        low += d_values[children[c]].getSize();
+      }
+      x = t.extract(low + w - 1, low);
+      break;
+    }
+    case BITVECTOR_EXTRACT:
+    {
+      unsigned high = utils::getExtractHigh(node);
+      unsigned low = utils::getExtractLow(node);
+      x = t;
+      if (low > 0)
+      {
+        x = x.concat(cur.extract(low - 1, 0));
+      }
+      if (high + 1 < w)
+      {
+        x = cur.extract(w - 1, high + 1).concat(x);
+      }
+      break;
+    }
+    case BITVECTOR_ZERO_EXTEND:
+    case BITVECTOR_SIGN_EXTEND: x = t.extract(w - 1, 0); break;
+    case BITVECTOR_UDIV:
+    case BITVECTOR_UREM:
+    case BITVECTOR_SHL:
+    case BITVECTOR_LSHR:
+    case BITVECTOR_ASHR:
+    {
+      if (!isInvertible(i, j, s, t)) return false;
+      if (j == 1 && k != BITVECTOR_UDIV && k != BITVECTOR_UREM)
+      {
+        /* Search the shift amount. */
+        for (unsigned a = 0; a <= w; ++a)
+        {
+          x = BitVector(w, a);
+          if (evaluate(i, j, x) == t) return true;
+        }
+        return false;
+      }
+      if (k == BITVECTOR_UDIV)
+      {
+        x = j == 0 ? (s == zero ? randomValue(w) : t * s)
+                   : (t == zero ? ones : s.unsignedDivTotal(t));
+      }
+      else if (k == BITVECTOR_UREM)
+      {
+        x = j == 0 ? t : (s == t ? zero : s - t);
+      }
+      else if (k == BITVECTOR_SHL)
+      {
+        x = t.logicalRightShift(s);
+      }
+      else
+      {
+        x = t.leftShift(s);
+        if (k == BITVECTOR_ASHR && evaluate(i, j, x) != t)
+        {
+          x = t;
+        }
+      }
+      break;
+    }
+    case BITVECTOR_ITE:
+    {
+      if (j > 0)
+      {
+        x = t;
+      }
+      else if (d_values[children[1]] == t || d_values[children[2]] == t)
+      {
+        x = BitVector(1, d_values[children[1]] == t ? 1u : 0u);
+      }
+      else
+      {
+        return false;
+      }
+      break;
+    }
+    default: return false;
+  }
+  return evaluate(i, j, x) == t;
+}
+
+bool BVLocalSearch::isInvertible(size_t i,
+                                 size_t j,
+                                 const BitVector& s,
+                                 const BitVector& t)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TNode node = d_terms[i];
+  Kind k = node.getKind();
+  Node x = node[j];
+  Node sn = nm->mkConst(s);
+  Node tn = nm->mkConst(t);
+  /* Operands of n-ary (commutative) operators are treated as the first. */
+  unsigned idx = node.getNumChildren() == 2 ? j : 0;
+
+  Node ic;
+  switch (k)
+  {
+    case BITVECTOR_ULT:
+      ic = quantifiers::utils::getICBvUltUgt(
+          t.isBitSet(0), j == 0 ? BITVECTOR_ULT : BITVECTOR_UGT, x, sn);
+      break;
+    case BITVECTOR_SLT:
+      ic = quantifiers::utils::getICBvSltSgt(
+          t.isBitSet(0), j == 0 ? BITVECTOR_SLT : BITVECTOR_SGT, x, sn);
+      break;
+    case BITVECTOR_MULT:
+      ic = quantifiers::utils::getICBvMult(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    case BITVECTOR_AND:
+    case BITVECTOR_OR:
+      ic = quantifiers::utils::getICBvAndOr(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    case BITVECTOR_UDIV:
+      ic = quantifiers::utils::getICBvUdiv(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    case BITVECTOR_UREM:
+      ic = quantifiers::utils::getICBvUrem(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    case BITVECTOR_SHL:
+      ic = quantifiers::utils::getICBvShl(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    case BITVECTOR_LSHR:
+      ic = quantifiers::utils::getICBvLshr(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    case BITVECTOR_ASHR:
+      ic = quantifiers::utils::getICBvAshr(true, EQUAL, k, idx, x, sn, tn);
+      break;
+    default: return true;
+  }
+
+  /* The condition is the antecedent of ic, over constants only. */
+  if (ic.getKind() != IMPLIES)
+  {
+    return true;
+  }
+  Node cond = Rewriter::rewrite(ic[0]);
+  return !cond.isConst() || cond.getConst<bool>();
+}
+
+BitVector BVLocalSearch::randomValue(unsigned size)
+{
+  Random& rnd = Random::getRandom();
+  Integer value(0);
+  for (unsigned i = 0; i < size; i += 64)
+  {
+    value = value.multiplyByPow2(64) + Integer(rnd.rand());
+  }
+  return BitVector(size, value);
+}
+
+BitVector BVLocalSearch::randomBetween(const BitVector& lo,
+                                       const BitVector& hi)
+{
+  Assert(lo.unsignedLessThanEq(hi));
+  unsigned size = lo.getSize();
+  Integer range = hi.toInteger() - lo.toInteger() + 1;
+  Integer r = randomValue(size + 64).toInteger().floorDivideRemainder(range);
+  return BitVector(size, lo.toInteger() + r);
+}
+
+BVLocalSearch::Statistics::Statistics()
+    : d_numChecks("theory::bv::BVLocalSearch::numChecks", 0),
+      d_numSat("theory::bv::BVLocalSearch::numSat", 0),
+      d_numMoves("theory::bv::BVLocalSearch::numMoves", 0),
+      d_numInverse("theory::bv::BVLocalSearch::numInverseValues", 0),
+      d_searchTime("theory::bv::BVLocalSearch::searchTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numChecks);
+  smtStatisticsRegistry()->registerStat(&d_numSat);
+  smtStatisticsRegistry()->registerStat(&d_numMoves);
+  smtStatisticsRegistry()->registerStat(&d_numInverse);
+  smtStatisticsRegistry()->registerStat(&d_searchTime);
+}
+
+BVLocalSearch::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numChecks);
+  smtStatisticsRegistry()->unregisterStat(&d_numSat);
+  smtStatisticsRegistry()->unregisterStat(&d_numMoves);
+  smtStatisticsRegistry()->unregisterStat(&d_numInverse);
+  smtStatisticsRegistry()->unregisterStat(&d_searchTime);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,155 @@
+/*********************                                                        */
+/*! \file bv_local_search.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Propagation-based local search over bit-vector values.
+ **
+ ** Propagation-based local search over bit-vector values, following
+ ** Niemetz, Preiner, Biere: "Propagation based local search for bit-precise
+ ** reasoning" (FMSD 2017).
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_LOCAL_SEARCH_H
+#define CVC4__THEORY__BV__BV_LOCAL_SEARCH_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/bitvector.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+/**
+ * Word-level local search for an assignment to the leaves of a set of
+ * bit-vector facts.
+ *
+ * The facts and their terms are kept as a DAG of values. A move selects an
+ * unsatisfied fact and propagates its target value down a path to a leaf: at
+ * each operator, a child is selected and assigned an inverse value, i.e., a
+ * value that makes the operator produce its target given the current values
+ * of the other children. Whether such a value exists is decided by the
+ * invertibility conditions of bv_inverter_utils.h; if it does not, the child
+ * is assigned a random value instead. The leaf takes the value that reaches
+ * it and the values of its cone are updated.
+ *
+ * The assignment of the leaves is kept between calls to check() and serves as
+ * initial assignment of the next search.
+ */
+class BVLocalSearch
+{
+ public:
+  BVLocalSearch();
+
+  /**
+   * Search for an assignment of the leaves that satisfies all (possibly
+   * negated) bit-vector atoms in `facts` within `maxMoves` moves. Returns
+   * true if one was found, and false if the search gave up or the facts
+   * contain operators that are not supported.
+   */
+  bool check(const std::vector<Node>& facts, uint64_t maxMoves);
+
+  /**
+   * Get the value of the leaf `node` in the assignment found by the last
+   * successful call to check(), or the null node if `node` is no leaf of the
+   * facts of that call.
+   */
+  Node getValue(TNode node) const;
+
+ private:
+  /** Marks an index that is no child. */
+  static constexpr size_t s_none = static_cast<size_t>(-1);
+
+  /**
+   * Build the DAG of `facts` and evaluate it under the current assignment.
+   * Returns false if some term is not supported.
+   */
+  bool buildDag(const std::vector<Node>& facts);
+  /** Index of `node` in the DAG, adding its (supported) cone if necessary. */
+  size_t addTerm(TNode node);
+  /** Whether the operator of non-leaf `node` is supported. */
+  static bool isSupported(TNode node);
+
+  /**
+   * Value of DAG node `i` under the current values of its children, where
+   * child `j` has value `x` instead if `j` is not s_none.
+   */
+  BitVector evaluate(size_t i,
+                     size_t j = s_none,
+                     const BitVector& x = BitVector()) const;
+  /** Set the value of leaf `i` to `value` and update the values of its cone. */
+  void assign(size_t i, const BitVector& value);
+
+  /** Propagate the target value of the unsatisfied fact `root` to a leaf. */
+  void move(size_t root);
+  /**
+   * Compute in `x` an inverse value for child `j` of DAG node `i`, such that
+   * `i` evaluates to `t`. Returns false if there is none or none was found.
+   */
+  bool inverseValue(size_t i, size_t j, const BitVector& t, BitVector& x);
+  /**
+   * Check the invertibility condition of child `j` of node `i` for target
+   * `t`, where `s` is the value of the other (binary) operand. Returns true
+   * for operators without invertibility condition.
+   */
+  bool isInvertible(size_t i,
+                    size_t j,
+                    const BitVector& s,
+                    const BitVector& t);
+
+  /** A random value of width `size`. */
+  static BitVector randomValue(unsigned size);
+  /** A random value in the (unsigned) range [lo, hi]. */
+  static BitVector randomBetween(const BitVector& lo, const BitVector& hi);
+
+  /** The terms of the DAG, children before parents */
+  std::vector<Node> d_terms;
+  /** Maps terms to their index in `d_terms` */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_index;
+  /** The children of each term, by index */
+  std::vector<std::vector<size_t>> d_children;
+  /** The parents of each term, by index */
+  std::vector<std::vector<size_t>> d_parents;
+  /** Whether a term is a leaf, i.e., is assigned a value by the search */
+  std::vector<bool> d_isLeaf;
+  /** The current value of each term. Atoms have values of width one. */
+  std::vector<BitVector> d_values;
+  /** The atoms of the facts and their polarity */
+  std::vector<std::pair<size_t, bool>> d_roots;
+
+  /** The assignment of leaves, kept across calls to check() */
+  std::unordered_map<Node, BitVector, NodeHashFunction> d_assignment;
+  /** The model found by the last successful call to check() */
+  std::unordered_map<Node, Node, NodeHashFunction> d_model;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numChecks;
+    IntStat d_numSat;
+    IntStat d_numMoves;
+    IntStat d_numInverse;
+    TimerStat d_searchTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif
@@ -16,6 +16,9 @@
 
 #include "theory/bv/bv_solver_bitblast.h"
 
+#include <algorithm>
+
+#include "expr/node_algorithm.h"
 #include "options/bv_options.h"
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_statistics_registry.h"
@@ -31,17 +34,17 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
                                    TheoryInferenceManager& inferMgr,
                                    ProofNodeManager* pnm)
     : BVSolver(*s, inferMgr),
-      d_bitblaster(new BBSimple(s)),
       d_nullRegistrar(new prop::NullRegistrar()),
       d_nullContext(new context::Context()),
       d_bbFacts(s->getSatContext()),
-      d_assumptions(s->getSatContext()),
+      d_facts(s->getSatContext()),
       d_invalidateModelCache(s->getSatContext(), true),
       d_inSatMode(s->getSatContext(), false),
+      d_inLocalSearchMode(s->getSatContext(), false),
+      d_inSlicerMode(s->getSatContext(), false),
       d_epg(pnm ? new EagerProofGenerator(pnm, s->getUserContext(), "")
                 : nullptr),
-      d_factLiteralCache(s->getSatContext()),
-      d_literalFactCache(s->getSatContext()),
+      d_numChecks(0),
       d_propagate(options::bitvectorPropagate())
 {
   if (pnm != nullptr)
@@ -49,6 +52,29 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
     d_bvProofChecker.registerTo(pnm->getChecker());
   }
 
+  initSatSolver();
+  if (options::bvLocalSearch())
+  {
+    d_localSearch.reset(new BVLocalSearch());
+  }
+  if (options::bvSlicing())
+  {
+    d_slicer.reset(new Slicer());
+  }
+  if (options::bvLinearSolver())
+  {
+    d_linearSolver.reset(new BVLinearSolver());
+  }
+}
+
+void BVSolverBitblast::initSatSolver()
+{
+  /* Destroy the users of the SAT solver before the solver itself. */
+  d_aigBitblaster.reset();
+  d_cnfStream.reset();
+  d_bitblaster.reset(new BBSimple(&d_state));
+  d_satSolver.reset();
+
   switch (options::bvSatSolver())
   {
     case options::SatSolverMode::CRYPTOMINISAT:
@@ -64,6 +90,10 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
                                         d_nullContext.get(),
                                         nullptr,
                                         smt::currentResourceManager()));
+  if (options::bvAigBitblaster())
+  {
+    d_aigBitblaster.reset(new BBAig(d_satSolver.get()));
+  }
 }
 
 void BVSolverBitblast::postCheck(Theory::Effort level)
@@ -77,31 +107,127 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
     }
   }
 
-  /* Process bit-blast queue and store SAT literals. */
+  /* Process bit-blast queue. */
   while (!d_bbFacts.empty())
   {
-    Node fact = d_bbFacts.front();
+    d_facts.push_back(d_bbFacts.front());
     d_bbFacts.pop();
-    /* Bit-blast fact and cache literal. */
-    if (d_factLiteralCache.find(fact) == d_factLiteralCache.end())
+  }
+
+  if (level == Theory::Effort::EFFORT_FULL)
+  {
+    ++d_numChecks;
+    collectGarbage();
+  }
+
+  /* Solve facts that are equalities of concatenations and extracts only
+   * without bit-blasting them. */
+  if (level == Theory::Effort::EFFORT_FULL && d_slicer
+      && std::all_of(d_facts.begin(), d_facts.end(), Slicer::isSupported))
+  {
+    std::vector<Node> facts(d_facts.begin(), d_facts.end());
+    Slicer::Result res = d_slicer->check(facts);
+    if (res == Slicer::Result::SAT)
+    {
+      Debug("bv-bitblast") << "model found by slicing" << std::endl;
+      d_invalidateModelCache.set(true);
+      d_inSatMode = true;
+      d_inSlicerMode = true;
+      return;
+    }
+    if (res == Slicer::Result::UNSAT)
+    {
+      NodeManager* nm = NodeManager::currentNM();
+      d_im.conflict(nm->mkAnd(d_slicer->getConflict()),
+                    InferenceId::BV_BITBLAST_CONFLICT);
+      return;
+    }
+  }
+  d_inSlicerMode = false;
+
+  /* Try to find a model with local search before anything is bit-blasted,
+   * and fall back to the SAT solver if the move limit is reached. */
+  if (level == Theory::Effort::EFFORT_FULL && d_localSearch)
+  {
+    std::vector<Node> facts(d_facts.begin(), d_facts.end());
+    if (d_localSearch->check(facts, options::bvLocalSearchMoves()))
     {
-      d_bitblaster->bbAtom(fact);
-      Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
-      d_cnfStream->ensureLiteral(bb_fact);
+      Debug("bv-bitblast") << "model found by local search" << std::endl;
+      d_invalidateModelCache.set(true);
+      d_inSatMode = true;
+      d_inLocalSearchMode = true;
+      return;
+    }
+  }
+  d_inLocalSearchMode = false;
 
-      prop::SatLiteral lit = d_cnfStream->getLiteral(bb_fact);
-      d_factLiteralCache[fact] = lit;
-      d_literalFactCache[lit] = fact;
+  /* Solve the linear facts first. Their conflicts need no bit-blasting, and
+   * the values they imply are added to the SAT solver as implications. */
+  if (level == Theory::Effort::EFFORT_FULL && d_linearSolver)
+  {
+    std::vector<Node> facts(d_facts.begin(), d_facts.end());
+    NodeManager* nm = NodeManager::currentNM();
+    if (!d_linearSolver->check(facts))
+    {
+      d_im.conflict(nm->mkAnd(d_linearSolver->getConflict()),
+                    InferenceId::BV_BITBLAST_CONFLICT);
+      return;
+    }
+    for (const auto& p : d_linearSolver->getPropagations())
+    {
+      Node lemma = nm->mkNode(kind::IMPLIES, nm->mkAnd(p.second), p.first);
+      if (!d_linearLemmas.insert(lemma).second)
+      {
+        continue;
+      }
+      prop::SatClause clause;
+      for (const Node& reason : p.second)
+      {
+        clause.push_back(~getFactLiteral(reason));
+      }
+      clause.push_back(getFactLiteral(p.first));
+      d_factLastCheck[p.first] = d_numChecks;
+      d_satSolver->addClause(clause, false);
+    }
+  }
+
+  /* Bit-blast the new facts on several threads first. */
+  if (d_aigBitblaster && options::bvBitblastThreads() > 1)
+  {
+    std::vector<Node> atoms;
+    for (const Node& fact : d_facts)
+    {
+      if (d_factLiteralCache.find(fact) == d_factLiteralCache.end())
+      {
+        atoms.push_back(options::bvLazyNonlinear() ? abstractNonlinear(fact)
+                                                   : fact);
+      }
     }
-    d_assumptions.push_back(d_factLiteralCache[fact]);
+    d_aigBitblaster->bbAtoms(atoms, options::bvBitblastThreads());
+  }
+
+  /* Bit-blast facts if necessary and collect their SAT literals. */
+  std::vector<prop::SatLiteral> assumptions;
+  for (const Node& fact : d_facts)
+  {
+    assumptions.push_back(getFactLiteral(fact));
+    d_factLastCheck[fact] = d_numChecks;
   }
 
   d_invalidateModelCache.set(true);
-  std::vector<prop::SatLiteral> assumptions(d_assumptions.begin(),
-                                            d_assumptions.end());
-  prop::SatValue val = d_satSolver->solve(assumptions);
-  d_inSatMode = val == prop::SatValue::SAT_VALUE_TRUE;
-  Debug("bv-bitblast") << "d_inSatMode: " << d_inSatMode << std::endl;
+
+  prop::SatValue val;
+  do
+  {
+    d_invalidateModelCache.set(true);
+    val = d_satSolver->solve(assumptions);
+    d_inSatMode = val == prop::SatValue::SAT_VALUE_TRUE;
+    Debug("bv-bitblast") << "d_inSatMode: " << d_inSatMode << std::endl;
+    /* Re-solve after bit-blasting the abstracted operators that are violated
+     * by the model. */
+  } while (val == prop::SatValue::SAT_VALUE_TRUE
+           && level == Theory::Effort::EFFORT_FULL
+           && options::bvLazyNonlinear() && refineNonlinear());
 
   if (val == prop::SatValue::SAT_VALUE_FALSE)
   {
@@ -109,10 +235,18 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
     d_satSolver->getUnsatAssumptions(unsat_assumptions);
     Assert(unsat_assumptions.size() > 0);
 
+    /* Facts may share a literal, take the ones that are asserted. */
+    std::unordered_map<prop::SatLiteral, Node, prop::SatLiteralHashFunction>
+        literalFacts;
+    for (size_t i = 0, size = assumptions.size(); i < size; ++i)
+    {
+      literalFacts.emplace(assumptions[i], d_facts[i]);
+    }
+
     std::vector<Node> conflict;
     for (const prop::SatLiteral& lit : unsat_assumptions)
     {
-      conflict.push_back(d_literalFactCache[lit]);
+      conflict.push_back(literalFacts[lit]);
       Debug("bv-bitblast") << "unsat assumption (" << lit
                            << "): " << conflict.back() << std::endl;
     }
@@ -140,7 +274,12 @@ bool BVSolverBitblast::collectModelValues(TheoryModel* m,
 {
   for (const auto& term : termSet)
   {
-    if (!d_bitblaster->isVariable(term))
+    bool isVariable =
+        d_inSlicerMode ? !d_slicer->getValue(term).isNull()
+        : d_inLocalSearchMode ? !d_localSearch->getValue(term).isNull()
+        : d_aigBitblaster ? d_aigBitblaster->isVariable(term)
+                          : d_bitblaster->isVariable(term);
+    if (!isVariable)
     {
       continue;
     }
@@ -183,11 +322,40 @@ Node BVSolverBitblast::getValueFromSatSolver(TNode node, bool initialize)
     return node;
   }
 
-  if (!d_bitblaster->hasBBTerm(node))
+  if (d_inLocalSearchMode || d_inSlicerMode)
+  {
+    Node value = d_inSlicerMode ? d_slicer->getValue(node)
+                                : d_localSearch->getValue(node);
+    if (value.isNull() && initialize)
+    {
+      return utils::mkConst(utils::getSize(node), 0u);
+    }
+    return value;
+  }
+
+  if (!hasBBTerm(node))
   {
     return initialize ? utils::mkConst(utils::getSize(node), 0u) : Node();
   }
 
+  if (d_aigBitblaster)
+  {
+    std::vector<AigLit> bits;
+    d_aigBitblaster->getBBTerm(node, bits);
+    Integer value(0), one(1), zero(0);
+    bool bit;
+    for (size_t i = 0, size = bits.size(), j = size - 1; i < size; ++i, --j)
+    {
+      if (!d_aigBitblaster->getBitValue(bits[j], bit))
+      {
+        if (!initialize) return Node();
+        bit = false;
+      }
+      value = value * 2 + (bit ? one : zero);
+    }
+    return utils::mkConst(bits.size(), value);
+  }
+
   std::vector<Node> bits;
   d_bitblaster->getBBTerm(node, bits);
   Integer value(0), one(1), zero(0), bit;
@@ -232,7 +400,7 @@ Node BVSolverBitblast::getValue(TNode node)
       continue;
     }
 
-    if (d_bitblaster->hasBBTerm(cur))
+    if (hasBBTerm(cur))
     {
       Node value = getValueFromSatSolver(cur, false);
       if (value.isConst())
@@ -279,6 +447,293 @@ Node BVSolverBitblast::getValue(TNode node)
   return it->second;
 }
 
+prop::SatLiteral BVSolverBitblast::bitblastFact(TNode fact)
+{
+  if (d_aigBitblaster)
+  {
+    return d_aigBitblaster->getSatLiteral(fact);
+  }
+  {
+    TimerStat::CodeTimer timer(d_statistics.d_bitblastTime);
+    d_bitblaster->bbAtom(fact);
+  }
+  Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
+  TimerStat::CodeTimer timer(d_statistics.d_cnfConversionTime);
+  d_cnfStream->ensureLiteral(bb_fact);
+  return d_cnfStream->getLiteral(bb_fact);
+}
+
+bool BVSolverBitblast::hasBBTerm(TNode node) const
+{
+  return d_aigBitblaster ? d_aigBitblaster->hasBBTerm(node)
+                         : d_bitblaster->hasBBTerm(node);
+}
+
+prop::SatLiteral BVSolverBitblast::getFactLiteral(TNode fact)
+{
+  auto it = d_factLiteralCache.find(fact);
+  if (it != d_factLiteralCache.end())
+  {
+    return it->second;
+  }
+  Node bbFact = fact;
+  if (options::bvLazyNonlinear())
+  {
+    bbFact = abstractNonlinear(fact);
+    d_factSkolems[fact] = getNonlinearSkolems(bbFact);
+  }
+  prop::SatLiteral lit = bitblastFact(bbFact);
+  d_factLiteralCache.emplace(fact, lit);
+  return lit;
+}
+
+void BVSolverBitblast::collectGarbage()
+{
+  uint64_t interval = options::bvGcChecks();
+  if (interval == 0 || d_numChecks % interval != 0)
+  {
+    return;
+  }
+
+  size_t stale = 0;
+  for (const auto& p : d_factLiteralCache)
+  {
+    auto it = d_factLastCheck.find(p.first);
+    if (it == d_factLastCheck.end() || it->second + interval < d_numChecks)
+    {
+      ++stale;
+    }
+  }
+  /* Re-bit-blasting the asserted facts only pays off if the circuits of most
+   * facts are unused. */
+  if (2 * stale <= d_factLiteralCache.size())
+  {
+    return;
+  }
+
+  Debug("bv-bitblast") << "rebuilding SAT solver, " << stale << " of "
+                       << d_factLiteralCache.size() << " facts unused"
+                       << std::endl;
+  ++d_statistics.d_numRebuilds;
+  d_factLiteralCache.clear();
+  d_factLastCheck.clear();
+  d_abstractionCache.clear();
+  d_abstractions.clear();
+  d_factSkolems.clear();
+  d_modelCache.clear();
+  d_linearLemmas.clear();
+  initSatSolver();
+}
+
+Node BVSolverBitblast::abstractNonlinear(TNode node)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<TNode> visit{node};
+  do
+  {
+    TNode cur = visit.back();
+    auto it = d_abstractionCache.find(cur);
+    if (it != d_abstractionCache.end() && !it->second.isNull())
+    {
+      visit.pop_back();
+      continue;
+    }
+    /* Leaves are bit-blasted as variables, their subterms are kept. */
+    if (Theory::isLeafOf(cur, theory::THEORY_BV))
+    {
+      d_abstractionCache[cur] = cur;
+      visit.pop_back();
+      continue;
+    }
+    if (it == d_abstractionCache.end())
+    {
+      d_abstractionCache.emplace(cur, Node());
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    visit.pop_back();
+
+    NodeBuilder<> nb(cur.getKind());
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      nb << cur.getOperator();
+    }
+    for (const TNode& child : cur)
+    {
+      nb << d_abstractionCache[child];
+    }
+    Node res = nb.constructNode();
+
+    Kind k = res.getKind();
+    if (k == kind::BITVECTOR_MULT || k == kind::BITVECTOR_UDIV
+        || k == kind::BITVECTOR_UREM)
+    {
+      Node skolem = nm->mkSkolem(
+          "bvnl", res.getType(), "abstraction of a nonlinear bit-vector term");
+      d_abstractions.emplace(
+          skolem,
+          NonlinearAbstraction{res, getNonlinearSkolems(res), false});
+      addNonlinearAxioms(skolem, res);
+      ++d_statistics.d_numAbstractions;
+      Debug("bv-bitblast") << "abstract " << res << " by " << skolem
+                           << std::endl;
+      res = skolem;
+    }
+    d_abstractionCache[cur] = res;
+  } while (!visit.empty());
+  return d_abstractionCache[node];
+}
+
+std::vector<Node> BVSolverBitblast::getNonlinearSkolems(TNode node) const
+{
+  std::unordered_set<Node, NodeHashFunction> syms;
+  expr::getSymbols(node, syms);
+  std::vector<Node> skolems;
+  for (const Node& sym : syms)
+  {
+    if (d_abstractions.find(sym) != d_abstractions.end())
+    {
+      skolems.push_back(sym);
+    }
+  }
+  return skolems;
+}
+
+void BVSolverBitblast::addNonlinearAxioms(TNode skolem, TNode term)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  unsigned size = utils::getSize(term);
+  Node zero = utils::mkZero(size);
+  Node one = utils::mkOne(size);
+  switch (term.getKind())
+  {
+    case kind::BITVECTOR_MULT:
+    {
+      Node lsb = utils::mkExtract(skolem, 0, 0);
+      Node bit0 = utils::mkZero(1);
+      for (const Node& child : term)
+      {
+        // child = 0 => skolem = 0
+        addClause({child.eqNode(zero).notNode(), skolem.eqNode(zero)});
+        // child[0] = 0 => skolem[0] = 0
+        addClause({utils::mkExtract(child, 0, 0).eqNode(bit0).notNode(),
+                   lsb.eqNode(bit0)});
+      }
+      if (term.getNumChildren() == 2)
+      {
+        // x = 1 => skolem = y, y = 1 => skolem = x
+        addClause({term[0].eqNode(one).notNode(), skolem.eqNode(term[1])});
+        addClause({term[1].eqNode(one).notNode(), skolem.eqNode(term[0])});
+      }
+      break;
+    }
+    case kind::BITVECTOR_UDIV:
+    {
+      Node divByZero = term[1].eqNode(zero);
+      // y = 0 => skolem = ~0
+      addClause({divByZero.notNode(), skolem.eqNode(utils::mkOnes(size))});
+      // y != 0 => skolem <= x
+      addClause({divByZero, nm->mkNode(kind::BITVECTOR_ULE, skolem, term[0])});
+      // y = 1 => skolem = x
+      addClause({term[1].eqNode(one).notNode(), skolem.eqNode(term[0])});
+      break;
+    }
+    case kind::BITVECTOR_UREM:
+    {
+      Node divByZero = term[1].eqNode(zero);
+      // y = 0 => skolem = x
+      addClause({divByZero.notNode(), skolem.eqNode(term[0])});
+      // y != 0 => skolem < y
+      addClause({divByZero, nm->mkNode(kind::BITVECTOR_ULT, skolem, term[1])});
+      // skolem <= x
+      addClause({nm->mkNode(kind::BITVECTOR_ULE, skolem, term[0])});
+      break;
+    }
+    default: Unreachable();
+  }
+}
+
+void BVSolverBitblast::addClause(const std::vector<Node>& lits)
+{
+  prop::SatClause clause;
+  for (const Node& lit : lits)
+  {
+    clause.push_back(bitblastFact(lit));
+  }
+  d_satSolver->addClause(clause, false);
+}
+
+bool BVSolverBitblast::refineNonlinear()
+{
+  /* Only the abstractions in the cone of the asserted facts are checked. */
+  std::vector<Node> visit;
+  for (const Node& fact : d_facts)
+  {
+    const std::vector<Node>& skolems = d_factSkolems[fact];
+    visit.insert(visit.end(), skolems.begin(), skolems.end());
+  }
+
+  bool refined = false;
+  std::unordered_set<Node, NodeHashFunction> visited;
+  while (!visit.empty())
+  {
+    Node skolem = visit.back();
+    visit.pop_back();
+    if (!visited.insert(skolem).second)
+    {
+      continue;
+    }
+    NonlinearAbstraction& abs = d_abstractions.at(skolem);
+    visit.insert(visit.end(), abs.d_skolems.begin(), abs.d_skolems.end());
+    if (abs.d_refined)
+    {
+      continue;
+    }
+
+    NodeBuilder<> nb(abs.d_term.getKind());
+    for (const Node& child : abs.d_term)
+    {
+      nb << getValue(child);
+    }
+    Node expected = d_evaluator.eval(nb.constructNode(), {}, {});
+    Assert(expected.isConst());
+    if (getValue(skolem) == expected)
+    {
+      continue;
+    }
+    Debug("bv-bitblast") << "refine " << skolem << " = " << abs.d_term
+                         << std::endl;
+    addClause({skolem.eqNode(abs.d_term)});
+    abs.d_refined = true;
+    refined = true;
+    ++d_statistics.d_numRefinements;
+  }
+  return refined;
+}
+
+BVSolverBitblast::Statistics::Statistics()
+    : d_numAbstractions("theory::bv::BVSolverBitblast::numAbstractions", 0),
+      d_numRefinements("theory::bv::BVSolverBitblast::numRefinements", 0),
+      d_numRebuilds("theory::bv::BVSolverBitblast::numRebuilds", 0),
+      d_bitblastTime("theory::bv::BVSolverBitblast::bitblastTime"),
+      d_cnfConversionTime("theory::bv::BVSolverBitblast::cnfConversionTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numAbstractions);
+  smtStatisticsRegistry()->registerStat(&d_numRefinements);
+  smtStatisticsRegistry()->registerStat(&d_numRebuilds);
+  smtStatisticsRegistry()->registerStat(&d_bitblastTime);
+  smtStatisticsRegistry()->registerStat(&d_cnfConversionTime);
+}
+
+BVSolverBitblast::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numAbstractions);
+  smtStatisticsRegistry()->unregisterStat(&d_numRefinements);
+  smtStatisticsRegistry()->unregisterStat(&d_numRebuilds);
+  smtStatisticsRegistry()->unregisterStat(&d_bitblastTime);
+  smtStatisticsRegistry()->unregisterStat(&d_cnfConversionTime);
+}
+
 }  // namespace bv
 }  // namespace theory
 }  // namespace CVC4
@@ -20,14 +20,21 @@
 #define CVC4__THEORY__BV__BV_SOLVER_BITBLAST_H
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include "context/cdqueue.h"
 #include "prop/cnf_stream.h"
 #include "prop/sat_solver.h"
+#include "theory/bv/bitblast/aig_simple_bitblaster.h"
 #include "theory/bv/bitblast/simple_bitblaster.h"
+#include "theory/bv/bv_linear_solver.h"
+#include "theory/bv/bv_local_search.h"
 #include "theory/bv/bv_solver.h"
 #include "theory/bv/proof_checker.h"
+#include "theory/bv/slicer.h"
 #include "theory/eager_proof_generator.h"
+#include "theory/evaluator.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 
@@ -36,6 +43,19 @@ namespace bv {
 
 /**
  * Bit-blasting solver with support for different SAT back ends.
+ *
+ * The solver is incremental: facts are bit-blasted once into a single SAT
+ * solver that is never popped, and each check solves the literals of the
+ * currently asserted facts as assumptions. The circuits of terms and atoms
+ * hence survive (user-level) pops and are reused when facts over the same
+ * terms are asserted again.
+ *
+ * Circuits of facts that are no longer asserted stay in the SAT solver. If
+ * options::bvGcChecks() is N > 0, every N full checks the solver counts the
+ * facts whose circuits were not used in the last N checks. If they are the
+ * majority, the SAT solver and the bit-blaster are rebuilt and only the facts
+ * asserted at that point are bit-blasted again, which bounds the memory of
+ * long incremental sessions.
  */
 class BVSolverBitblast : public BVSolver
 {
@@ -96,9 +116,62 @@ class BVSolverBitblast : public BVSolver
    */
   std::unordered_map<Node, Node, NodeHashFunction> d_modelCache;
 
+  /**
+   * Bit-blast `fact` and return its SAT literal, using the bit-blaster
+   * selected by options::bvAigBitblaster().
+   */
+  prop::SatLiteral bitblastFact(TNode fact);
+
+  /** Checks whether `node` was bit-blasted already. */
+  bool hasBBTerm(TNode node) const;
+
+  /** Create the SAT solver, CNF stream and bit-blasters. */
+  void initSatSolver();
+
+  /** Get the SAT literal of `fact`, bit-blasting it if necessary. */
+  prop::SatLiteral getFactLiteral(TNode fact);
+
+  /**
+   * Rebuild the SAT solver if most bit-blasted facts were not used during
+   * the last options::bvGcChecks() checks.
+   */
+  void collectGarbage();
+
+  /**
+   * Replace the multiplications, divisions and remainders in `node` by
+   * skolems, and add their axioms to the SAT solver. Used if
+   * options::bvLazyNonlinear() is set.
+   */
+  Node abstractNonlinear(TNode node);
+
+  /** Get the skolems of abstractNonlinear() that occur in `node`. */
+  std::vector<Node> getNonlinearSkolems(TNode node) const;
+
+  /** Add the axioms of `skolem`, the abstraction of `term`. */
+  void addNonlinearAxioms(TNode skolem, TNode term);
+
+  /**
+   * Add a clause of the literals of (possibly negated) atoms to the SAT
+   * solver.
+   */
+  void addClause(const std::vector<Node>& lits);
+
+  /**
+   * Check the abstractions in the currently asserted facts against the model
+   * of the SAT solver, and bit-blast the operators of those that are
+   * violated. Returns true if some abstraction was refined.
+   */
+  bool refineNonlinear();
+
   /** Bit-blaster used to bit-blast atoms/terms. */
   std::unique_ptr<BBSimple> d_bitblaster;
 
+  /**
+   * Bit-blaster into an AIG, used instead of `d_bitblaster` and `d_cnfStream`
+   * if options::bvAigBitblaster() is set.
+   */
+  std::unique_ptr<BBAig> d_aigBitblaster;
+
   /** Used for initializing `d_cnfStream`. */
   std::unique_ptr<prop::NullRegistrar> d_nullRegistrar;
   std::unique_ptr<context::Context> d_nullContext;
@@ -115,8 +188,8 @@ class BVSolverBitblast : public BVSolver
    */
   context::CDQueue<Node> d_bbFacts;
 
-  /** Corresponds to the SAT literals of the currently asserted facts. */
-  context::CDList<prop::SatLiteral> d_assumptions;
+  /** The currently asserted facts, solved as assumptions. */
+  context::CDList<Node> d_facts;
 
   /** Flag indicating whether `d_modelCache` should be invalidated. */
   context::CDO<bool> d_invalidateModelCache;
@@ -124,21 +197,104 @@ class BVSolverBitblast : public BVSolver
   /** Indicates whether the last check() call was satisfiable. */
   context::CDO<bool> d_inSatMode;
 
+  /**
+   * Local search run on the facts before bit-blasting them if
+   * options::bvLocalSearch() is set.
+   */
+  std::unique_ptr<BVLocalSearch> d_localSearch;
+
+  /**
+   * Indicates whether the model of the last check() call was found by
+   * `d_localSearch`, in which case values are taken from its assignment.
+   */
+  context::CDO<bool> d_inLocalSearchMode;
+
+  /**
+   * Solver for facts that are equalities of concatenations and extracts,
+   * used instead of bit-blasting them if options::bvSlicing() is set.
+   */
+  std::unique_ptr<Slicer> d_slicer;
+
+  /**
+   * Indicates whether the model of the last check() call was found by
+   * `d_slicer`, in which case values are taken from its model.
+   */
+  context::CDO<bool> d_inSlicerMode;
+
+  /**
+   * Solver for the linear facts, run before bit-blasting them if
+   * options::bvLinearSolver() is set.
+   */
+  std::unique_ptr<BVLinearSolver> d_linearSolver;
+
+  /**
+   * The implications of values by linear facts that were added to the SAT
+   * solver, cleared when it is rebuilt.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_linearLemmas;
+
   /** Proof generator that manages proofs for lemmas generated by this class. */
   std::unique_ptr<EagerProofGenerator> d_epg;
 
   BVProofRuleChecker d_bvProofChecker;
 
-  /** Stores the SatLiteral for a given fact. */
-  context::CDHashMap<Node, prop::SatLiteral, NodeHashFunction>
+  /**
+   * Stores the SatLiteral for a given fact. Not context-dependent, as the
+   * clauses of the fact are never removed from the SAT solver.
+   */
+  std::unordered_map<Node, prop::SatLiteral, NodeHashFunction>
       d_factLiteralCache;
 
-  /** Reverse map of `d_factLiteralCache`. */
-  context::CDHashMap<prop::SatLiteral, Node, prop::SatLiteralHashFunction>
-      d_literalFactCache;
+  /** Stores the last full check in which a bit-blasted fact was asserted. */
+  std::unordered_map<Node, uint64_t, NodeHashFunction> d_factLastCheck;
+
+  /** The number of full checks so far. */
+  uint64_t d_numChecks;
 
   /** Option to enable/disable bit-level propagation. */
   bool d_propagate;
+
+  /** An abstraction of a nonlinear term by a skolem. */
+  struct NonlinearAbstraction
+  {
+    /** The abstracted term, whose operands are abstracted already */
+    Node d_term;
+    /** The skolems in the operands of `d_term` */
+    std::vector<Node> d_skolems;
+    /** Whether the operator of `d_term` was bit-blasted */
+    bool d_refined;
+  };
+
+  /** Caches the results of abstractNonlinear(). */
+  std::unordered_map<Node, Node, NodeHashFunction> d_abstractionCache;
+
+  /** Maps the skolems introduced by abstractNonlinear() to their terms. */
+  std::unordered_map<Node, NonlinearAbstraction, NodeHashFunction>
+      d_abstractions;
+
+  /** Stores the skolems in the abstraction of a given fact. */
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction> d_factSkolems;
+
+  /** Evaluator used to check abstractions against the model. */
+  Evaluator d_evaluator;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numAbstractions;
+    IntStat d_numRefinements;
+    IntStat d_numRebuilds;
+    /**
+     * Time spent bit-blasting facts into nodes and converting them to CNF,
+     * the counterparts of the times of BBAig.
+     */
+    TimerStat d_bitblastTime;
+    TimerStat d_cnfConversionTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
 };
 
 }  // namespace bv
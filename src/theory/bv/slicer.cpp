@@ -15,8 +15,13 @@
  **/
 #include "theory/bv/slicer.h"
 
+#include <unordered_set>
+
+#include "smt/smt_statistics_registry.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
+#include "theory/theory.h"
+#include "util/random.h"
 
 using namespace std; 
 
@@ -78,6 +83,484 @@ std::string Base::debugPrint() const {
   return os.str(); 
 }
 
+/**
+ * Slicer
+ *
+ */
+Slicer::Slicer() : d_statistics() {}
+
+bool Slicer::isSupported(TNode fact)
+{
+  TNode atom = fact.getKind() == kind::NOT ? fact[0] : fact;
+  if (atom.getKind() != kind::EQUAL || !atom[0].getType().isBitVector())
+  {
+    return false;
+  }
+  std::vector<TNode> visit{atom[0], atom[1]};
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    Kind k = cur.getKind();
+    if (k == kind::BITVECTOR_CONCAT || k == kind::BITVECTOR_EXTRACT)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else if (k != kind::CONST_BITVECTOR && !Theory::isLeafOf(cur, THEORY_BV))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+Slicer::Result Slicer::check(const std::vector<Node>& facts)
+{
+  TimerStat::CodeTimer timer(d_statistics.d_solveTime);
+  ++d_statistics.d_numChecks;
+  d_conflict.clear();
+  d_model.clear();
+
+  if (!solve(facts))
+  {
+    d_conflict = explain({}, false, facts);
+    ++d_statistics.d_numUnsat;
+    return Result::UNSAT;
+  }
+  if (!buildModel())
+  {
+    return Result::UNKNOWN;
+  }
+  ++d_statistics.d_numSat;
+  return Result::SAT;
+}
+
+Node Slicer::getValue(TNode node) const
+{
+  auto it = d_model.find(node);
+  return it == d_model.end() ? Node::null() : it->second;
+}
+
+void Slicer::reset()
+{
+  d_leaves.clear();
+  d_leafIndex.clear();
+  d_bases.clear();
+  d_slices.clear();
+  d_diseqs.clear();
+  d_pieceIndex.clear();
+  d_parent.clear();
+  d_size.clear();
+  d_value.clear();
+  d_hasValue.clear();
+}
+
+bool Slicer::solve(const std::vector<Node>& facts)
+{
+  reset();
+  std::vector<std::pair<const Slices*, const Slices*>> sides;
+  for (TNode fact : facts)
+  {
+    TNode atom = fact.getKind() == kind::NOT ? fact[0] : fact;
+    const Slices& a = normalize(atom[0]);
+    const Slices& b = normalize(atom[1]);
+    sides.emplace_back(&a, &b);
+  }
+
+  // Cut both sides of each fact at the cut points of either side, until the
+  // cut points of all sides agree.
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (const auto& s : sides)
+    {
+      std::set<Index> boundaries;
+      getBoundaries(*s.first, boundaries);
+      getBoundaries(*s.second, boundaries);
+      changed = cut(*s.first, boundaries) || changed;
+      changed = cut(*s.second, boundaries) || changed;
+    }
+  }
+
+  for (size_t i = 0, size = facts.size(); i < size; ++i)
+  {
+    // Constants are not cut, hence the boundaries of both sides are needed.
+    std::set<Index> boundaries;
+    getBoundaries(*sides[i].first, boundaries);
+    getBoundaries(*sides[i].second, boundaries);
+    std::vector<Piece> a, b;
+    getPieces(*sides[i].first, boundaries, a);
+    getPieces(*sides[i].second, boundaries, b);
+    Assert(a.size() == b.size());
+    if (facts[i].getKind() == kind::NOT)
+    {
+      d_diseqs.emplace_back(a, b);
+      continue;
+    }
+    for (size_t j = 0, n = a.size(); j < n; ++j)
+    {
+      if (!merge(a[j], b[j]))
+      {
+        return false;
+      }
+    }
+  }
+
+  // A disequality is violated if all its base slices are equal.
+  for (const auto& diseq : d_diseqs)
+  {
+    bool equal = true;
+    for (size_t j = 0, n = diseq.first.size(); j < n && equal; ++j)
+    {
+      const Piece& a = diseq.first[j];
+      const Piece& b = diseq.second[j];
+      uint32_t ra = a.first == s_const ? s_const : find(a.first);
+      uint32_t rb = b.first == s_const ? s_const : find(b.first);
+      if (ra != s_const && ra == rb)
+      {
+        continue;
+      }
+      bool hasA = ra == s_const || d_hasValue[ra];
+      bool hasB = rb == s_const || d_hasValue[rb];
+      equal = hasA && hasB
+              && (ra == s_const ? a.second : d_value[ra])
+                     == (rb == s_const ? b.second : d_value[rb]);
+    }
+    if (equal)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+const Slicer::Slices& Slicer::normalize(TNode term)
+{
+  auto it = d_slices.find(term);
+  if (it != d_slices.end())
+  {
+    return it->second;
+  }
+
+  Slices res;
+  Index size = utils::getSize(term);
+  switch (term.getKind())
+  {
+    case kind::CONST_BITVECTOR:
+      res.push_back({s_const, size - 1, 0, term.getConst<BitVector>()});
+      break;
+
+    case kind::BITVECTOR_CONCAT:
+      for (size_t i = term.getNumChildren(); i-- > 0;)
+      {
+        const Slices& child = normalize(term[i]);
+        res.insert(res.end(), child.begin(), child.end());
+      }
+      break;
+
+    case kind::BITVECTOR_EXTRACT:
+    {
+      Index high = utils::getExtractHigh(term);
+      Index low = utils::getExtractLow(term);
+      Index offset = 0;
+      for (const Slice& slice : normalize(term[0]))
+      {
+        Index end = offset + slice.getSize() - 1;
+        if (end >= low && offset <= high)
+        {
+          Index from = std::max(low, offset) - offset;
+          Index to = std::min(high, end) - offset;
+          res.push_back({slice.d_leaf,
+                         slice.d_low + to,
+                         slice.d_low + from,
+                         slice.d_value});
+        }
+        offset = end + 1;
+      }
+      break;
+    }
+
+    default:
+    {
+      auto lit = d_leafIndex.find(term);
+      if (lit == d_leafIndex.end())
+      {
+        lit = d_leafIndex.emplace(term, d_leaves.size()).first;
+        d_leaves.push_back(term);
+        d_bases.emplace_back(size);
+      }
+      res.push_back({lit->second, size - 1, 0, BitVector()});
+    }
+  }
+  return d_slices.emplace(term, res).first->second;
+}
+
+void Slicer::getBoundaries(const Slices& slices,
+                           std::set<Index>& boundaries) const
+{
+  Index offset = 0;
+  boundaries.insert(0);
+  for (const Slice& slice : slices)
+  {
+    if (slice.d_leaf != s_const)
+    {
+      const Base& base = d_bases[slice.d_leaf];
+      for (Index c = slice.d_low + 1; c <= slice.d_high; ++c)
+      {
+        if (base.isCutPoint(c))
+        {
+          boundaries.insert(offset + c - slice.d_low);
+        }
+      }
+    }
+    offset += slice.getSize();
+    boundaries.insert(offset);
+  }
+}
+
+bool Slicer::cut(const Slices& slices, const std::set<Index>& boundaries)
+{
+  bool changed = false;
+  Index offset = 0;
+  for (const Slice& slice : slices)
+  {
+    Index end = offset + slice.getSize();
+    if (slice.d_leaf != s_const)
+    {
+      Base& base = d_bases[slice.d_leaf];
+      for (auto it = boundaries.upper_bound(offset);
+           it != boundaries.end() && *it < end;
+           ++it)
+      {
+        Index c = slice.d_low + *it - offset;
+        if (!base.isCutPoint(c))
+        {
+          base.sliceAt(c);
+          changed = true;
+        }
+      }
+    }
+    offset = end;
+  }
+  return changed;
+}
+
+void Slicer::getPieces(const Slices& slices,
+                       const std::set<Index>& boundaries,
+                       std::vector<Piece>& pieces)
+{
+  auto slice = slices.begin();
+  Index offset = 0;
+  for (auto it = boundaries.begin(), next = std::next(it);
+       next != boundaries.end();
+       it = next, ++next)
+  {
+    while (*it >= offset + slice->getSize())
+    {
+      offset += slice->getSize();
+      ++slice;
+    }
+    Index low = slice->d_low + *it - offset;
+    Index size = *next - *it;
+    Assert(*next <= offset + slice->getSize());
+    if (slice->d_leaf == s_const)
+    {
+      pieces.emplace_back(s_const, slice->d_value.extract(low + size - 1, low));
+      continue;
+    }
+    uint64_t key = (static_cast<uint64_t>(slice->d_leaf) << 32) | low;
+    auto pit = d_pieceIndex.find(key);
+    if (pit == d_pieceIndex.end())
+    {
+      pit = d_pieceIndex.emplace(key, d_parent.size()).first;
+      d_parent.push_back(d_parent.size());
+      d_size.push_back(size);
+      d_value.emplace_back();
+      d_hasValue.push_back(false);
+    }
+    Assert(d_size[pit->second] == size);
+    pieces.emplace_back(pit->second, BitVector());
+  }
+}
+
+uint32_t Slicer::find(uint32_t id)
+{
+  while (d_parent[id] != id)
+  {
+    id = d_parent[id] = d_parent[d_parent[id]];
+  }
+  return id;
+}
+
+bool Slicer::merge(const Piece& a, const Piece& b)
+{
+  if (a.first == s_const && b.first == s_const)
+  {
+    return a.second == b.second;
+  }
+  if (a.first == s_const || b.first == s_const)
+  {
+    const Piece& c = a.first == s_const ? a : b;
+    uint32_t r = find(a.first == s_const ? b.first : a.first);
+    if (d_hasValue[r])
+    {
+      return d_value[r] == c.second;
+    }
+    d_value[r] = c.second;
+    d_hasValue[r] = true;
+    return true;
+  }
+  uint32_t ra = find(a.first);
+  uint32_t rb = find(b.first);
+  if (ra == rb)
+  {
+    return true;
+  }
+  if (d_hasValue[ra] && d_hasValue[rb])
+  {
+    return d_value[ra] == d_value[rb];
+  }
+  if (d_hasValue[ra])
+  {
+    std::swap(ra, rb);
+  }
+  d_parent[ra] = rb;
+  return true;
+}
+
+BitVector Slicer::getPieceValue(const Piece& piece)
+{
+  return piece.first == s_const ? piece.second
+                                : d_classValue[find(piece.first)];
+}
+
+bool Slicer::buildModel()
+{
+  // The first attempt assigns consecutive values to the free classes, the
+  // others random values.
+  constexpr unsigned maxAttempts = 8;
+  Random& rnd = Random::getRandom();
+  bool found = false;
+  for (unsigned attempt = 0; attempt < maxAttempts && !found; ++attempt)
+  {
+    d_classValue.assign(d_parent.size(), BitVector());
+    uint64_t counter = 0;
+    for (uint32_t id = 0, size = d_parent.size(); id < size; ++id)
+    {
+      if (find(id) != id)
+      {
+        continue;
+      }
+      if (d_hasValue[id])
+      {
+        d_classValue[id] = d_value[id];
+        continue;
+      }
+      Integer value(attempt == 0 ? counter++ : 0);
+      for (Index i = 0; attempt > 0 && i < d_size[id]; i += 64)
+      {
+        value = value.multiplyByPow2(64) + Integer(rnd.rand());
+      }
+      d_classValue[id] = BitVector(d_size[id], value);
+    }
+
+    found = true;
+    for (const auto& diseq : d_diseqs)
+    {
+      bool equal = true;
+      for (size_t j = 0, n = diseq.first.size(); j < n && equal; ++j)
+      {
+        equal = getPieceValue(diseq.first[j]) == getPieceValue(diseq.second[j]);
+      }
+      if (equal)
+      {
+        found = false;
+        break;
+      }
+    }
+  }
+  if (!found)
+  {
+    return false;
+  }
+
+  // The value of a leaf is the concatenation of the values of its base
+  // slices, where bits that occur in no fact are zero.
+  for (uint32_t leaf = 0, size = d_leaves.size(); leaf < size; ++leaf)
+  {
+    Index width = utils::getSize(d_leaves[leaf]);
+    BitVector value;
+    for (Index low = 0; low < width;)
+    {
+      Index high = low + 1;
+      while (!d_bases[leaf].isCutPoint(high))
+      {
+        ++high;
+      }
+      auto it = d_pieceIndex.find((static_cast<uint64_t>(leaf) << 32) | low);
+      BitVector piece = it == d_pieceIndex.end()
+                            ? BitVector::mkZero(high - low)
+                            : d_classValue[find(it->second)];
+      value = low == 0 ? piece : piece.concat(value);
+      low = high;
+    }
+    d_model[d_leaves[leaf]] = utils::mkConst(value);
+  }
+  return true;
+}
+
+std::vector<Node> Slicer::explain(const std::vector<Node>& background,
+                                  bool checkBackground,
+                                  const std::vector<Node>& candidates)
+{
+  if (checkBackground && !solve(background))
+  {
+    return {};
+  }
+  if (candidates.size() == 1)
+  {
+    return candidates;
+  }
+  size_t half = candidates.size() / 2;
+  std::vector<Node> first(candidates.begin(), candidates.begin() + half);
+  std::vector<Node> second(candidates.begin() + half, candidates.end());
+
+  std::vector<Node> b1 = background;
+  b1.insert(b1.end(), first.begin(), first.end());
+  std::vector<Node> d2 = explain(b1, true, second);
+  std::vector<Node> b2 = background;
+  b2.insert(b2.end(), d2.begin(), d2.end());
+  std::vector<Node> d1 = explain(b2, !d2.empty(), first);
+  d1.insert(d1.end(), d2.begin(), d2.end());
+  return d1;
+}
+
+Slicer::Statistics::Statistics()
+    : d_numChecks("theory::bv::Slicer::numChecks", 0),
+      d_numSat("theory::bv::Slicer::numSat", 0),
+      d_numUnsat("theory::bv::Slicer::numUnsat", 0),
+      d_solveTime("theory::bv::Slicer::solveTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numChecks);
+  smtStatisticsRegistry()->registerStat(&d_numSat);
+  smtStatisticsRegistry()->registerStat(&d_numUnsat);
+  smtStatisticsRegistry()->registerStat(&d_solveTime);
+}
+
+Slicer::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numChecks);
+  smtStatisticsRegistry()->unregisterStat(&d_numSat);
+  smtStatisticsRegistry()->unregisterStat(&d_numUnsat);
+  smtStatisticsRegistry()->unregisterStat(&d_solveTime);
+}
+
 
 }  // namespace bv
 }  // namespace theory
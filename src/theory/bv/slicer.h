@@ -19,9 +19,15 @@
 #ifndef CVC4__THEORY__BV__SLICER_BV_H
 #define CVC4__THEORY__BV__SLICER_BV_H
 
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
+
+#include "expr/node.h"
+#include "util/bitvector.h"
 #include "util/index.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -49,6 +55,147 @@ public:
   }
 }; 
 
+/**
+ * Solver for conjunctions of (possibly negated) equalities between terms
+ * built from constants, extracts and concatenations of leaves, i.e.,
+ * variables and terms of other theories.
+ *
+ * Terms are normalized into lists of slices, i.e., extracts of leaves and
+ * of constants. The cut points of every leaf are kept in a Base, and refined
+ * until both sides of every (dis)equality are cut at the same positions.
+ * Each equality then splits into equalities between base slices of leaves
+ * and constants, which are merged with union-find. A conflict arises if a
+ * class gets two different constants, or if a disequality has only pairwise
+ * equal slices.
+ *
+ * Otherwise, a model assigns the classes their constants or distinct values.
+ * Disequalities that are violated by it (over narrow slices) are left to
+ * the bit-blaster.
+ */
+class Slicer
+{
+ public:
+  enum class Result
+  {
+    SAT,
+    UNSAT,
+    UNKNOWN
+  };
+
+  Slicer();
+
+  /** Whether the (possibly negated) atom `fact` is supported. */
+  static bool isSupported(TNode fact);
+
+  /**
+   * Check the supported `facts`. If the result is UNSAT, getConflict()
+   * returns a minimal subset of the facts that is unsatisfiable.
+   */
+  Result check(const std::vector<Node>& facts);
+
+  /** The conflict of the last check() that returned UNSAT. */
+  const std::vector<Node>& getConflict() const { return d_conflict; }
+
+  /**
+   * The value of leaf `node` in the model of the last check() that returned
+   * SAT, or the null node if `node` is no leaf of its facts.
+   */
+  Node getValue(TNode node) const;
+
+ private:
+  /** Marks slices of constants */
+  static constexpr uint32_t s_const = static_cast<uint32_t>(-1);
+
+  /** The bits [d_high:d_low] of leaf d_leaf, or of constant d_value */
+  struct Slice
+  {
+    uint32_t d_leaf;
+    Index d_high;
+    Index d_low;
+    BitVector d_value;
+    Index getSize() const { return d_high - d_low + 1; }
+  };
+  /** Slices, least significant first */
+  using Slices = std::vector<Slice>;
+  /** A base slice: its class, or s_const and its value */
+  using Piece = std::pair<uint32_t, BitVector>;
+
+  /** Clear the state of the last call to solve(). */
+  void reset();
+  /** Process `facts` and return false on conflict. */
+  bool solve(const std::vector<Node>& facts);
+  /** The slices of `term` */
+  const Slices& normalize(TNode term);
+  /** The positions of the cut points of the slices in `slices` */
+  void getBoundaries(const Slices& slices, std::set<Index>& boundaries) const;
+  /**
+   * Cut the leaves of `slices` at `boundaries`. Returns true if a new cut
+   * point was added.
+   */
+  bool cut(const Slices& slices, const std::set<Index>& boundaries);
+  /** The base slices of `slices` between `boundaries` */
+  void getPieces(const Slices& slices,
+                 const std::set<Index>& boundaries,
+                 std::vector<Piece>& pieces);
+  /** The representative of the class of base slice `id` */
+  uint32_t find(uint32_t id);
+  /** Merge two base slices, returns false on conflict. */
+  bool merge(const Piece& a, const Piece& b);
+  /** The value of `piece` in the current model */
+  BitVector getPieceValue(const Piece& piece);
+  /**
+   * Assign values to the classes and check that the disequalities hold.
+   * Returns false if no such assignment was found.
+   */
+  bool buildModel();
+
+  /**
+   * Compute a minimal subset of `candidates` that is unsatisfiable together
+   * with `background`, following QuickXplain. If `checkBackground` is set,
+   * `background` alone may be unsatisfiable already.
+   */
+  std::vector<Node> explain(const std::vector<Node>& background,
+                            bool checkBackground,
+                            const std::vector<Node>& candidates);
+
+  /** The leaves of the facts, their indices and cut points */
+  std::vector<Node> d_leaves;
+  std::unordered_map<Node, uint32_t, NodeHashFunction> d_leafIndex;
+  std::vector<Base> d_bases;
+  /** Caches normalize() */
+  std::unordered_map<Node, Slices, NodeHashFunction> d_slices;
+  /** The sides of the disequalities, aligned with each other */
+  std::vector<std::pair<std::vector<Piece>, std::vector<Piece>>> d_diseqs;
+
+  /** The base slices, by leaf and low index */
+  std::unordered_map<uint64_t, uint32_t> d_pieceIndex;
+  /** The union-find of base slices, their sizes and constant values */
+  std::vector<uint32_t> d_parent;
+  std::vector<Index> d_size;
+  std::vector<BitVector> d_value;
+  std::vector<bool> d_hasValue;
+  /** The value of each class in the model, by representative */
+  std::vector<BitVector> d_classValue;
+
+  /** The conflict of the last check() */
+  std::vector<Node> d_conflict;
+  /** The values of the leaves of the last satisfiable check() */
+  std::unordered_map<Node, Node, NodeHashFunction> d_model;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numChecks;
+    IntStat d_numSat;
+    IntStat d_numUnsat;
+    TimerStat d_solveTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
 }/* CVC4::theory::bv namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
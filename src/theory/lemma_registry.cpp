@@ -0,0 +1,73 @@
+/*********************                                                        */
+/*! \file lemma_registry.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the global registry of lemmas.
+ **/
+
+#include "theory/lemma_registry.h"
+
+#include "smt/smt_statistics_registry.h"
+#include "theory/rewriter.h"
+
+namespace CVC4 {
+namespace theory {
+
+LemmaRegistry::LemmaRegistry(context::UserContext* u) : d_lemmas(u) {}
+
+LemmaRegistry::~LemmaRegistry() {}
+
+bool LemmaRegistry::registerLemma(TNode lem, InferenceId id, LemmaProperty p)
+{
+  Node rlem = Rewriter::rewrite(lem);
+  NodeIdMap::const_iterator it = d_lemmas.find(rlem);
+  if (it != d_lemmas.end())
+  {
+    Trace("lemma-registry") << "LemmaRegistry: duplicate lemma from " << id
+                            << " (first sent by " << (*it).second
+                            << "): " << rlem << std::endl;
+    ++d_statistics.d_numDuplicates;
+    d_statistics.d_dupIds << id;
+    d_statistics.d_dupOrigIds << (*it).second;
+    return false;
+  }
+  ++d_statistics.d_numLemmas;
+  d_statistics.d_lemmaIds << id;
+  if (!isLemmaPropertyRemovable(p))
+  {
+    d_lemmas[rlem] = id;
+  }
+  return true;
+}
+
+LemmaRegistry::Statistics::Statistics()
+    : d_numLemmas("theory::LemmaRegistry::numLemmas", 0),
+      d_numDuplicates("theory::LemmaRegistry::numDuplicates", 0),
+      d_lemmaIds("theory::LemmaRegistry::inferencesLemma"),
+      d_dupIds("theory::LemmaRegistry::inferencesDuplicate"),
+      d_dupOrigIds("theory::LemmaRegistry::inferencesDuplicated")
+{
+  smtStatisticsRegistry()->registerStat(&d_numLemmas);
+  smtStatisticsRegistry()->registerStat(&d_numDuplicates);
+  smtStatisticsRegistry()->registerStat(&d_lemmaIds);
+  smtStatisticsRegistry()->registerStat(&d_dupIds);
+  smtStatisticsRegistry()->registerStat(&d_dupOrigIds);
+}
+
+LemmaRegistry::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_numDuplicates);
+  smtStatisticsRegistry()->unregisterStat(&d_lemmaIds);
+  smtStatisticsRegistry()->unregisterStat(&d_dupIds);
+  smtStatisticsRegistry()->unregisterStat(&d_dupOrigIds);
+}
+
+}  // namespace theory
+}  // namespace CVC4
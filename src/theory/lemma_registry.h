@@ -0,0 +1,89 @@
+/*********************                                                        */
+/*! \file lemma_registry.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Global registry of lemmas sent by theory inference managers.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__LEMMA_REGISTRY_H
+#define CVC4__THEORY__LEMMA_REGISTRY_H
+
+#include "context/cdhashmap.h"
+#include "expr/node.h"
+#include "theory/inference_id.h"
+#include "theory/output_channel.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+/**
+ * A registry of the lemmas sent by all theories, maintained by TheoryEngine
+ * (--lemma-registry).
+ *
+ * Each theory inference manager caches the lemmas it sent, but does not know
+ * about the lemmas sent by others. This class records the rewritten form of
+ * every non-removable lemma sent via a theory inference manager, together
+ * with the inference that first produced it. Lemmas whose rewritten form is
+ * already in the registry are duplicates and are not sent again. Since
+ * non-removable lemmas are never deleted by the SAT solver, this is sound.
+ * Removable lemmas are never registered, since the SAT solver may delete them.
+ *
+ * The registry is user-context dependent, and hence also identifies
+ * duplicate lemmas sent across SAT restarts and check-sat calls. Its
+ * statistics record how often each inference produces a lemma, how often
+ * it produces a duplicate, and which inferences produced the lemmas that were
+ * duplicated.
+ */
+class LemmaRegistry
+{
+  typedef context::CDHashMap<Node, InferenceId, NodeHashFunction> NodeIdMap;
+
+ public:
+  LemmaRegistry(context::UserContext* u);
+  ~LemmaRegistry();
+  /**
+   * Register lemma lem with property p, which was produced by inference id.
+   * Returns false if lem is a duplicate of a lemma in this registry, in which
+   * case it should not be sent.
+   */
+  bool registerLemma(TNode lem, InferenceId id, LemmaProperty p);
+
+ private:
+  /** Maps the rewritten form of registered lemmas to their inference */
+  NodeIdMap d_lemmas;
+  /** Statistics */
+  class Statistics
+  {
+   public:
+    Statistics();
+    ~Statistics();
+    /** Number of lemmas that were registered */
+    IntStat d_numLemmas;
+    /** Number of duplicate lemmas that were not sent */
+    IntStat d_numDuplicates;
+    /** Counts the lemmas produced by each inference */
+    IntegralHistogramStat<InferenceId> d_lemmaIds;
+    /** Counts the duplicate lemmas produced by each inference */
+    IntegralHistogramStat<InferenceId> d_dupIds;
+    /**
+     * Counts the duplicate lemmas by the inference that first produced the
+     * lemma.
+     */
+    IntegralHistogramStat<InferenceId> d_dupOrigIds;
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__LEMMA_REGISTRY_H */
@@ -19,9 +19,16 @@ using namespace CVC4::kind;
 namespace CVC4 {
 namespace theory {
 
-RelevanceManager::RelevanceManager(context::UserContext* userContext,
+RelevanceManager::RelevanceManager(context::Context* satContext,
+                                   context::UserContext* userContext,
                                    Valuation val)
-    : d_val(val), d_input(userContext), d_computed(false), d_success(false)
+    : d_val(val),
+      d_input(userContext),
+      d_inputAtoms(userContext),
+      d_justified(satContext),
+      d_rset(satContext),
+      d_computed(false),
+      d_success(false)
 {
 }
 
@@ -42,7 +49,7 @@ void RelevanceManager::notifyPreprocessedAssertions(
     }
     else
     {
-      d_input.push_back(a);
+      toProcess.push_back(a);
     }
   }
   addAssertionsInternal(toProcess);
@@ -74,15 +81,41 @@ void RelevanceManager::addAssertionsInternal(std::vector<Node>& toProcess)
       // note that a could be a literal, in which case we could add it to
       // an "always relevant" set here.
       d_input.push_back(a);
+      addInputAtoms(a);
     }
     i++;
   }
 }
 
+void RelevanceManager::addInputAtoms(TNode n)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (visited.find(cur) == visited.end())
+    {
+      visited.insert(cur);
+      if (isBooleanConnective(cur))
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+      }
+      else
+      {
+        d_inputAtoms.insert(cur);
+      }
+    }
+  } while (!visit.empty());
+}
+
 void RelevanceManager::resetRound()
 {
+  // the relevant selection is SAT-context dependent, so we do not clear it
   d_computed = false;
-  d_rset.clear();
 }
 
 void RelevanceManager::computeRelevance()
@@ -92,6 +125,11 @@ void RelevanceManager::computeRelevance()
   std::unordered_map<TNode, int, TNodeHashFunction> cache;
   for (const Node& node: d_input)
   {
+    if (d_justified.find(node) != d_justified.end())
+    {
+      // already justified in this context
+      continue;
+    }
     TNode n = node;
     int val = justify(n, cache);
     if (val != 1)
@@ -104,6 +142,7 @@ void RelevanceManager::computeRelevance()
       d_success = false;
       return;
     }
+    d_justified.insert(node);
   }
   Trace("rel-manager") << "...success, size = " << d_rset.size() << std::endl;
   d_success = true;
@@ -311,5 +350,16 @@ bool RelevanceManager::isRelevant(Node lit)
   return d_rset.find(lit) != d_rset.end();
 }
 
+bool RelevanceManager::isIrrelevant(Node lit)
+{
+  Node atom = lit.getKind() == NOT ? lit[0] : lit;
+  if (d_inputAtoms.find(atom) == d_inputAtoms.end())
+  {
+    // does not occur in the input, we cannot filter it
+    return false;
+  }
+  return !isRelevant(atom);
+}
+
 }  // namespace theory
 }  // namespace CVC4
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "theory/valuation.h"
@@ -66,13 +67,24 @@ namespace theory {
  * asserted literal is part of the current relevant selection. The relevant
  * selection is computed lazily, i.e. only when someone asks if a literal is
  * relevant, and only at most once per FULL effort check.
+ *
+ * The relevant selection is maintained incrementally in the SAT context. Once
+ * an input formula is justified, the literals used to justify it remain
+ * assigned until the SAT solver backtracks past the point where the formula
+ * was justified. Hence, both the set of justified input formulas and the
+ * relevant selection are SAT-context dependent, and each FULL effort check
+ * only justifies the input formulas that have not been justified in the
+ * current context.
  */
 class RelevanceManager
 {
   typedef context::CDList<Node> NodeList;
+  typedef context::CDHashSet<Node, NodeHashFunction> NodeSet;
 
  public:
-  RelevanceManager(context::UserContext* userContext, Valuation val);
+  RelevanceManager(context::Context* satContext,
+                   context::UserContext* userContext,
+                   Valuation val);
   /**
    * Notify (preprocessed) assertions. This is called for input formulas or
    * lemmas that need justification that have been fully processed, just before
@@ -92,6 +104,16 @@ class RelevanceManager
    * during FULL or LAST_CALL efforts, through the Valuation class.
    */
   bool isRelevant(Node lit);
+  /**
+   * Can lit be skipped by a theory that only wishes to check relevant
+   * literals? This is the case if lit is not part of the current relevant
+   * selection, and its atom occurs in the formulas known to this class. Atoms
+   * that only occur in theory lemmas are never part of the relevant selection,
+   * yet they may be critical for the correctness of the theory that introduced
+   * them (e.g. when the lemma defines a skolem), and hence they are not
+   * skipped.
+   */
+  bool isIrrelevant(Node lit);
 
  private:
   /**
@@ -100,6 +122,8 @@ class RelevanceManager
    * of and.
    */
   void addAssertionsInternal(std::vector<Node>& toProcess);
+  /** Add the atoms of input formula n to d_inputAtoms. */
+  void addInputAtoms(TNode n);
   /** compute the relevant selection */
   void computeRelevance();
   /**
@@ -134,8 +158,12 @@ class RelevanceManager
   Valuation d_val;
   /** The input assertions */
   NodeList d_input;
-  /** The current relevant selection. */
-  std::unordered_set<TNode, TNodeHashFunction> d_rset;
+  /** The atoms occurring in the input assertions */
+  NodeSet d_inputAtoms;
+  /** The input assertions that are justified in the current SAT context */
+  NodeSet d_justified;
+  /** The current relevant selection, which is SAT-context dependent. */
+  NodeSet d_rset;
   /** Have we computed the relevant selection this round? */
   bool d_computed;
   /**
@@ -15,6 +15,7 @@
 #include "theory/shared_solver_distributed.h"
 
 #include "theory/theory_engine.h"
+#include "theory/theory_profiler.h"
 
 namespace CVC4 {
 namespace theory {
@@ -78,6 +79,8 @@ TrustNode SharedSolverDistributed::explain(TNode literal, TheoryId id)
   {
     // By default, we ask the individual theory for the explanation.
     // It is possible that a centralized approach could preempt this.
+    TheoryProfiler::Scope tps(
+        d_te.getProfiler(), id, TheoryProfiler::CALL_EXPLAIN);
     texp = d_te.theoryOf(id)->explain(literal);
     Trace("shared-solver") << "\tTerm was propagated by owner theory: " << id
                            << ". Explanation: " << texp.getNode() << std::endl;
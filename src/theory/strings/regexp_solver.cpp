@@ -67,13 +67,21 @@ void RegExpSolver::checkMemberships()
   std::map<Node, std::vector<Node> > assertedMems;
   const std::map<Node, ExtfInfoTmp>& einfo = d_esolver.getInfo();
   std::map<Node, ExtfInfoTmp>::const_iterator it;
+  bool useRelevance = options::stringRegExpRlv();
+  Valuation& val = d_state.getValuation();
   for (unsigned i = 0; i < mems.size(); i++)
   {
     Node n = mems[i];
     Assert(n.getKind() == STRING_IN_REGEXP);
     it = einfo.find(n);
     Assert(it != einfo.end());
-    if (!it->second.d_const.isNull())
+    if (useRelevance && val.isIrrelevant(n))
+    {
+      Trace("strings-process-debug")
+          << "  irrelevant (not in relevant selection) membership : " << n
+          << std::endl;
+    }
+    else if (!it->second.d_const.isNull())
     {
       bool pol = it->second.d_const.getConst<bool>();
       Trace("strings-process-debug")
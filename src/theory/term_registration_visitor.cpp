@@ -18,6 +18,7 @@
 #include "base/configuration.h"
 #include "options/quantifiers_options.h"
 #include "theory/theory_engine.h"
+#include "theory/theory_profiler.h"
 
 using namespace CVC4::theory;
 
@@ -193,6 +194,8 @@ void PreRegisterVisitor::preRegisterWithTheory(TheoryEngine* te,
   // call the theory's preRegisterTerm method
   visitedTheories = TheoryIdSetUtil::setInsert(id, visitedTheories);
   Theory* th = te->theoryOf(id);
+  TheoryProfiler::Scope tps(
+      te->getProfiler(), id, TheoryProfiler::CALL_PRE_REGISTER);
   th->preRegisterTerm(current);
 }
 
@@ -34,12 +34,14 @@
 #include "smt/logic_exception.h"
 #include "theory/combination_care_graph.h"
 #include "theory/decision_manager.h"
+#include "theory/lemma_registry.h"
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers_engine.h"
 #include "theory/relevance_manager.h"
 #include "theory/rewriter.h"
 #include "theory/theory.h"
 #include "theory/theory_engine_proof_generator.h"
+#include "theory/theory_profiler.h"
 #include "theory/theory_id.h"
 #include "theory/theory_model.h"
 #include "theory/theory_traits.h"
@@ -154,8 +156,17 @@ void TheoryEngine::finishInit()
   // create the relevance filter if any option requires it
   if (options::relevanceFilter())
   {
-    d_relManager.reset(
-        new RelevanceManager(d_userContext, theory::Valuation(this)));
+    d_relManager.reset(new RelevanceManager(
+        d_context, d_userContext, theory::Valuation(this)));
+  }
+  if (options::lemmaRegistry())
+  {
+    d_lemmaRegistry.reset(new LemmaRegistry(d_userContext));
+  }
+  if (options::theoryProfile())
+  {
+    d_profiler.reset(
+        new TheoryProfiler(d_logicInfo, options::theoryProfileSample()));
   }
 
   // initialize the quantifiers engine
@@ -226,6 +237,8 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_quantEngine(nullptr),
       d_decManager(new DecisionManager(userContext)),
       d_relManager(nullptr),
+      d_lemmaRegistry(nullptr),
+      d_profiler(nullptr),
       d_eager_model_building(false),
       d_inConflict(context, false),
       d_inSatMode(false),
@@ -236,7 +249,10 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_propagatedLiterals(context),
       d_propagatedLiteralsIndex(context, 0),
       d_atomRequests(context),
+      d_lemmaBatchActive(false),
       d_combineTheoriesTime("TheoryEngine::combineTheoriesTime"),
+      d_numBatchedLemmas("TheoryEngine::numBatchedLemmas", 0),
+      d_numBatchedLemmaDups("TheoryEngine::numBatchedLemmaDups", 0),
       d_true(),
       d_false(),
       d_interrupted(false),
@@ -258,6 +274,8 @@ TheoryEngine::TheoryEngine(context::Context* context,
   }
 
   smtStatisticsRegistry()->registerStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->registerStat(&d_numBatchedLemmas);
+  smtStatisticsRegistry()->registerStat(&d_numBatchedLemmaDups);
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
 }
@@ -273,6 +291,8 @@ TheoryEngine::~TheoryEngine() {
   }
 
   smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->unregisterStat(&d_numBatchedLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_numBatchedLemmaDups);
 }
 
 void TheoryEngine::interrupt() { d_interrupted = true; }
@@ -413,7 +433,11 @@ void TheoryEngine::check(Theory::Effort effort) {
   if (theory::TheoryTraits<THEORY>::hasCheck                        \
       && d_logicInfo.isTheoryEnabled(THEORY))                       \
   {                                                                 \
-    theoryOf(THEORY)->check(effort);                                \
+    {                                                               \
+      TheoryProfiler::Scope tps(                                    \
+          d_profiler.get(), THEORY, checkCall);                     \
+      theoryOf(THEORY)->check(effort);                              \
+    }                                                               \
     if (d_inConflict)                                               \
     {                                                               \
       Debug("conflict") << THEORY << " in conflict. " << std::endl; \
@@ -421,6 +445,9 @@ void TheoryEngine::check(Theory::Effort effort) {
     }                                                               \
   }
 
+  // The kind of call we are making, for profiling
+  TheoryProfiler::Call checkCall = TheoryProfiler::getCheckCall(effort);
+
   // Do the checking
   try {
 
@@ -465,8 +492,11 @@ void TheoryEngine::check(Theory::Effort effort) {
       // Note that we've discharged all the facts
       d_factsAsserted = false;
 
-      // Do the checking
+      // Do the checking, collecting the lemmas of all theories in a batch if
+      // lemma batching is enabled
+      d_lemmaBatchActive = options::lemmaBatch();
       CVC4_FOR_EACH_THEORY;
+      flushLemmaBatch();
 
       Debug("theory") << "TheoryEngine::check(" << effort << "): running propagation after the initial check" << endl;
 
@@ -488,6 +518,8 @@ void TheoryEngine::check(Theory::Effort effort) {
         }
       }
     }
+    // the loop above exits early on conflicts, send the remaining lemmas now
+    flushLemmaBatch();
 
     // Must consult quantifiers theory for last call to ensure sat, or otherwise add a lemma
     if( Theory::fullEffort(effort) && ! d_inConflict && ! needCheck() ) {
@@ -507,6 +539,9 @@ void TheoryEngine::check(Theory::Effort effort) {
               {
                 break;
               }
+              TheoryProfiler::Scope tps(d_profiler.get(),
+                                        theoryId,
+                                        TheoryProfiler::CALL_CHECK_LAST_CALL);
               theory->check(Theory::EFFORT_LAST_CALL);
             }
           }
@@ -516,6 +551,9 @@ void TheoryEngine::check(Theory::Effort effort) {
       {
         if(d_logicInfo.isQuantified()) {
           // quantifiers engine must check at last call effort
+          TheoryProfiler::Scope tps(d_profiler.get(),
+                                    THEORY_QUANTIFIERS,
+                                    TheoryProfiler::CALL_CHECK_LAST_CALL);
           d_quantEngine->check(Theory::EFFORT_LAST_CALL);
         }
       }
@@ -542,6 +580,7 @@ void TheoryEngine::check(Theory::Effort effort) {
     }
   } catch(const theory::Interrupted&) {
     Trace("theory") << "TheoryEngine::check() => interrupted" << endl;
+    flushLemmaBatch();
   }
   // If fulleffort, check all theories
   if(Dump.isOn("theory::fullcheck") && Theory::fullEffort(effort)) {
@@ -562,6 +601,7 @@ void TheoryEngine::propagate(Theory::Effort effort)
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
   if (theory::TheoryTraits<THEORY>::hasPropagate && d_logicInfo.isTheoryEnabled(THEORY)) { \
+    TheoryProfiler::Scope tps(d_profiler.get(), THEORY, TheoryProfiler::CALL_PROPAGATE); \
     theoryOf(THEORY)->propagate(effort); \
   }
 
@@ -752,6 +792,26 @@ bool TheoryEngine::isRelevant(Node lit) const
   return true;
 }
 
+bool TheoryEngine::isIrrelevant(Node lit) const
+{
+  if (d_relManager != nullptr)
+  {
+    return d_relManager->isIrrelevant(lit);
+  }
+  return false;
+}
+
+bool TheoryEngine::registerLemma(TNode lem,
+                                 theory::InferenceId id,
+                                 theory::LemmaProperty p)
+{
+  if (d_lemmaRegistry != nullptr)
+  {
+    return d_lemmaRegistry->registerLemma(lem, id, p);
+  }
+  return true;
+}
+
 void TheoryEngine::shutdown() {
   // Set this first; if a Theory shutdown() throws an exception,
   // at least the destruction of the TheoryEngine won't confound
@@ -1123,7 +1183,13 @@ TrustNode TheoryEngine::getExplanation(TNode node)
         << "TheoryEngine::getExplanation: sharing is NOT enabled. "
         << " Responsible theory is: " << theoryOf(atom)->getId() << std::endl;
 
-    TrustNode texplanation = theoryOf(atom)->explain(node);
+    TrustNode texplanation;
+    {
+      TheoryId tid = theoryOf(atom)->getId();
+      TheoryProfiler::Scope tps(
+          d_profiler.get(), tid, TheoryProfiler::CALL_EXPLAIN);
+      texplanation = theoryOf(atom)->explain(node);
+    }
     Node explanation = texplanation.getNode();
     Debug("theory::explain") << "TheoryEngine::getExplanation(" << node
                              << ") => " << explanation << endl;
@@ -1269,6 +1335,70 @@ void TheoryEngine::lemma(theory::TrustNode tlemma,
                          theory::LemmaProperty p,
                          theory::TheoryId atomsTo,
                          theory::TheoryId from)
+{
+  // conflicts are never batched, since the SAT solver must backtrack
+  if (d_lemmaBatchActive && tlemma.getKind() == TrustNodeKind::LEMMA)
+  {
+    Node lem = tlemma.getProven();
+    std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+        d_lemmaBatchIndex.find(lem);
+    if (it == d_lemmaBatchIndex.end())
+    {
+      Trace("te-lemma-batch") << "Batch lemma: " << lem << std::endl;
+      d_lemmaBatchIndex[lem] = d_lemmaBatch.size();
+      d_lemmaBatch.push_back(BatchedLemma(tlemma, p, atomsTo, from));
+    }
+    else
+    {
+      Trace("te-lemma-batch") << "Duplicate lemma: " << lem << std::endl;
+      ++d_numBatchedLemmaDups;
+      BatchedLemma& bl = d_lemmaBatch[it->second];
+      // The lemma is removable only if all copies of it are. We combine the
+      // other properties and send atoms if any copy requires it.
+      bool removable =
+          isLemmaPropertyRemovable(bl.d_p) && isLemmaPropertyRemovable(p);
+      bl.d_p = bl.d_p | p;
+      if (!removable)
+      {
+        bl.d_p = bl.d_p & static_cast<LemmaProperty>(
+                     ~static_cast<uint32_t>(LemmaProperty::REMOVABLE));
+      }
+      if (bl.d_atomsTo == THEORY_LAST)
+      {
+        bl.d_atomsTo = atomsTo;
+      }
+    }
+    // Mark that we added some lemmas
+    d_lemmasAdded = true;
+    return;
+  }
+  lemmaInternal(tlemma, p, atomsTo, from);
+}
+
+void TheoryEngine::flushLemmaBatch()
+{
+  d_lemmaBatchActive = false;
+  if (d_lemmaBatch.empty())
+  {
+    return;
+  }
+  Trace("te-lemma-batch") << "Flush " << d_lemmaBatch.size() << " lemmas"
+                          << std::endl;
+  // take the batch, since sending lemmas may lead to further calls to lemma
+  std::vector<BatchedLemma> batch;
+  batch.swap(d_lemmaBatch);
+  d_lemmaBatchIndex.clear();
+  d_numBatchedLemmas += batch.size();
+  for (const BatchedLemma& bl : batch)
+  {
+    lemmaInternal(bl.d_tlem, bl.d_p, bl.d_atomsTo, bl.d_from);
+  }
+}
+
+void TheoryEngine::lemmaInternal(theory::TrustNode tlemma,
+                                 theory::LemmaProperty p,
+                                 theory::TheoryId atomsTo,
+                                 theory::TheoryId from)
 {
   // For resource-limiting (also does a time check).
   // spendResource();
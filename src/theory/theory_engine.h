@@ -83,6 +83,8 @@ class CombinationEngine;
 class SharedSolver;
 class DecisionManager;
 class RelevanceManager;
+class LemmaRegistry;
+class TheoryProfiler;
 
 }/* CVC4::theory namespace */
 
@@ -157,6 +159,10 @@ class TheoryEngine {
   std::unique_ptr<theory::DecisionManager> d_decManager;
   /** The relevance manager */
   std::unique_ptr<theory::RelevanceManager> d_relManager;
+  /** The registry of lemmas sent by all theories */
+  std::unique_ptr<theory::LemmaRegistry> d_lemmaRegistry;
+  /** The profiler of calls to theories, if --theory-profile is enabled */
+  std::unique_ptr<theory::TheoryProfiler> d_profiler;
 
   /** are we in eager model building mode? (see setEagerModelBuilding). */
   bool d_eager_model_building;
@@ -269,6 +275,48 @@ class TheoryEngine {
              theory::LemmaProperty p,
              theory::TheoryId atomsTo = theory::THEORY_LAST,
              theory::TheoryId from = theory::THEORY_LAST);
+  /**
+   * Process and send the lemma to the prop engine. This is called by the
+   * above method, either immediately or when flushing the lemma batch.
+   */
+  void lemmaInternal(theory::TrustNode node,
+                     theory::LemmaProperty p,
+                     theory::TheoryId atomsTo,
+                     theory::TheoryId from);
+
+  /** A lemma whose delivery to the prop engine is deferred */
+  struct BatchedLemma
+  {
+    BatchedLemma(theory::TrustNode tlem,
+                 theory::LemmaProperty p,
+                 theory::TheoryId atomsTo,
+                 theory::TheoryId from)
+        : d_tlem(tlem), d_p(p), d_atomsTo(atomsTo), d_from(from)
+    {
+    }
+    /** The lemma */
+    theory::TrustNode d_tlem;
+    /** Its properties */
+    theory::LemmaProperty d_p;
+    /** The theory that atoms of the lemma should be sent to */
+    theory::TheoryId d_atomsTo;
+    /** The theory that sent the lemma */
+    theory::TheoryId d_from;
+  };
+  /**
+   * Are we collecting lemmas in d_lemmaBatch? This is true while theories are
+   * checked if lemma batching is enabled (--lemma-batch).
+   */
+  bool d_lemmaBatchActive;
+  /** The lemmas collected during the current check of the theories */
+  std::vector<BatchedLemma> d_lemmaBatch;
+  /** Maps the lemmas in d_lemmaBatch to their index in that vector */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_lemmaBatchIndex;
+  /**
+   * Stop collecting lemmas, and send all lemmas in the current batch to the
+   * prop engine, in the order in which they were first sent.
+   */
+  void flushLemmaBatch();
 
   /** Enusre that the given atoms are send to the given theory */
   void ensureLemmaAtoms(const std::vector<TNode>& atoms, theory::TheoryId theory);
@@ -278,6 +326,10 @@ class TheoryEngine {
 
   /** Time spent in theory combination */
   TimerStat d_combineTheoriesTime;
+  /** Number of lemmas that were sent to the prop engine as part of a batch */
+  IntStat d_numBatchedLemmas;
+  /** Number of duplicate lemmas that were removed from a batch */
+  IntStat d_numBatchedLemmaDups;
 
   Node d_true;
   Node d_false;
@@ -369,6 +421,11 @@ class TheoryEngine {
   {
     return d_decManager.get();
   }
+  /**
+   * Get the profiler of calls to theories, which is null if --theory-profile
+   * is not enabled.
+   */
+  theory::TheoryProfiler* getProfiler() const { return d_profiler.get(); }
 
  private:
   /**
@@ -460,6 +517,21 @@ class TheoryEngine {
    * or during LAST_CALL effort.
    */
   bool isRelevant(Node lit) const;
+  /**
+   * Can the asserted literal lit be skipped by theories that only check
+   * relevant literals? This call is applicable during FULL or LAST_CALL effort.
+   * See RelevanceManager::isIrrelevant.
+   */
+  bool isIrrelevant(Node lit) const;
+  /**
+   * Register lemma lem with property p, produced by inference id, with the
+   * global lemma registry (--lemma-registry). Returns false if lem is a
+   * duplicate of a lemma that was already sent, in which case it should not
+   * be sent again.
+   */
+  bool registerLemma(TNode lem,
+                     theory::InferenceId id,
+                     theory::LemmaProperty p);
   /**
    * This is called at shutdown time by the SmtEngine, just before
    * destruction.  It is important because there are destruction
@@ -244,6 +244,11 @@ bool TheoryInferenceManager::trustedLemma(const TrustNode& tlem,
       return false;
     }
   }
+  // check whether another theory has already sent this lemma
+  if (!d_theoryState.getValuation().registerLemma(tlem.getNode(), id, p))
+  {
+    return false;
+  }
   d_lemmaIdStats << id;
   d_numCurrentLemmas++;
   d_out.trustedLemma(tlem, p);
@@ -19,6 +19,7 @@
 #include "options/smt_options.h"
 #include "options/theory_options.h"
 #include "options/uf_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/uf/theory_uf_model.h"
 
 using namespace std;
@@ -63,6 +64,26 @@ Node TheoryEngineModelBuilder::Assigner::getNextAssignment()
 
 TheoryEngineModelBuilder::TheoryEngineModelBuilder() {}
 
+TheoryEngineModelBuilder::~TheoryEngineModelBuilder() {}
+
+TheoryEngineModelBuilder::Statistics::Statistics()
+    : d_numBuilds("theory::TheoryEngineModelBuilder::numBuilds", 0),
+      d_numEnumAssigned("theory::TheoryEngineModelBuilder::numEnumAssigned",
+                        0),
+      d_numReused("theory::TheoryEngineModelBuilder::numReused", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numBuilds);
+  smtStatisticsRegistry()->registerStat(&d_numEnumAssigned);
+  smtStatisticsRegistry()->registerStat(&d_numReused);
+}
+
+TheoryEngineModelBuilder::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numBuilds);
+  smtStatisticsRegistry()->unregisterStat(&d_numEnumAssigned);
+  smtStatisticsRegistry()->unregisterStat(&d_numReused);
+}
+
 Node TheoryEngineModelBuilder::evaluateEqc(TheoryModel* m, TNode r)
 {
   eq::EqClassIterator eqc_i = eq::EqClassIterator(r, m->d_equalityEngine);
@@ -329,6 +350,49 @@ bool TheoryEngineModelBuilder::isExcludedUSortValue(
   return false;
 }
 
+Node TheoryEngineModelBuilder::getReusableValue(TheoryModel* tm,
+                                                Node eqc,
+                                                TypeSet& typeConstSet)
+{
+  TypeNode tn = eqc.getType();
+  TypeNode tb = tn.getBaseType();
+  std::set<Node>* usedSet = typeConstSet.getSet(tb);
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, tm->d_equalityEngine);
+  for (; !eqc_i.isFinished(); ++eqc_i)
+  {
+    NodeMap::const_iterator it = d_prevAssignedValues.find(*eqc_i);
+    if (it == d_prevAssignedValues.end())
+    {
+      continue;
+    }
+    Node v = it->second;
+    // the value must have a type compatible with the equivalence class, and
+    // must not be the value of another equivalence class of this type
+    if (!v.getType().isSubtypeOf(tn)
+        || (usedSet != nullptr && usedSet->find(v) != usedSet->end()))
+    {
+      continue;
+    }
+    Trace("model-builder-debug")
+        << "Reuse value " << v << " for " << eqc << " from term " << *eqc_i
+        << std::endl;
+    typeConstSet.addWithSubTerms(tb, v);
+    return v;
+  }
+  return Node::null();
+}
+
+void TheoryEngineModelBuilder::recordAssignedValue(TheoryModel* tm,
+                                                   Node eqc,
+                                                   Node v)
+{
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, tm->d_equalityEngine);
+  for (; !eqc_i.isFinished(); ++eqc_i)
+  {
+    d_currAssignedValues[*eqc_i] = v;
+  }
+}
+
 void TheoryEngineModelBuilder::addToTypeList(
     TypeNode tn,
     std::vector<TypeNode>& type_list,
@@ -375,6 +439,17 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
 {
   Trace("model-builder") << "TheoryEngineModelBuilder: buildModel" << std::endl;
   eq::EqualityEngine* ee = tm->d_equalityEngine;
+  ++d_statistics.d_numBuilds;
+  // Values we assign via enumeration in this call become the candidates for
+  // reuse in the next call. We only reuse values if we are not doing finite
+  // model finding, since the cardinality bounds on uninterpreted sorts may
+  // have changed since the last build.
+  bool reuseValues = options::modelReuse() && !options::finiteModelFind();
+  d_prevAssignedValues.clear();
+  if (reuseValues)
+  {
+    d_prevAssignedValues.swap(d_currAssignedValues);
+  }
 
   Trace("model-builder")
       << "TheoryEngineModelBuilder: Preprocess build model..." << std::endl;
@@ -792,8 +867,17 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
             // assign uninterpreted constants to equivalence classes in its
             // collectModelValues method. Doing so would have the same effect
             // as running the code in this case.
-            bool success;
-            do
+            bool success = false;
+            if (reuseValues && !isCorecursive)
+            {
+              n = getReusableValue(tm, *i2, typeConstSet);
+              if (!n.isNull())
+              {
+                ++d_statistics.d_numReused;
+                success = true;
+              }
+            }
+            while (!success)
             {
               Trace("model-builder-debug") << "Enumerate term of type " << t
                                            << std::endl;
@@ -840,8 +924,12 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
                 }
               }
               //---
-            } while (!success);
+            }
             Assert(!n.isNull());
+            if (reuseValues)
+            {
+              recordAssignedValue(tm, *i2, n);
+            }
           }
           else
           {
@@ -852,6 +940,7 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
             n = *te;
           }
           Trace("model-builder-debug") << "...got " << n << std::endl;
+          ++d_statistics.d_numEnumAssigned;
           assignConstantRep(tm, *i2, n);
           changed = true;
           noRepSet.erase(i2);
@@ -21,6 +21,7 @@
 #include <unordered_set>
 
 #include "theory/theory_model.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 
@@ -48,7 +49,7 @@ class TheoryEngineModelBuilder
 
  public:
   TheoryEngineModelBuilder();
-  virtual ~TheoryEngineModelBuilder() {}
+  virtual ~TheoryEngineModelBuilder();
   /**
    * Should be called only on models m after they have been prepared
    * (e.g. using ModelManager). In other words, the equality engine of model
@@ -210,6 +211,29 @@ class TheoryEngineModelBuilder
   void assignFunctions(TheoryModel* m);
 
  private:
+  /** get reusable value
+   *
+   * If model reuse is enabled, this returns a value that was assigned via
+   * type enumeration to a term in the equivalence class eqc in the previous
+   * call to buildModel, provided that value is not already in use by another
+   * equivalence class of the same type, as recorded in typeConstSet. If such a
+   * value exists, it is added to typeConstSet. Otherwise, this returns null.
+   */
+  Node getReusableValue(TheoryModel* tm, Node eqc, TypeSet& typeConstSet);
+  /** record assigned value
+   *
+   * Remember that the equivalence class eqc was assigned value v via type
+   * enumeration in the current call to buildModel.
+   */
+  void recordAssignedValue(TheoryModel* tm, Node eqc, Node v);
+  /**
+   * Maps terms to the value that was assigned to their equivalence class via
+   * type enumeration in the previous call to buildModel. Only populated if
+   * model reuse is enabled.
+   */
+  NodeMap d_prevAssignedValues;
+  /** The analog of the above map for the current call to buildModel. */
+  NodeMap d_currAssignedValues;
   /** normalized cache
    * A temporary cache mapping terms to their
    * normalized form, used during buildModel.
@@ -339,6 +363,21 @@ class TheoryEngineModelBuilder
                             std::map<Node, bool>& visited);
   //---------------------------------end for debugging finite model finding
 
+  /** Statistics for model building */
+  class Statistics
+  {
+   public:
+    Statistics();
+    ~Statistics();
+    /** Number of calls to buildModel */
+    IntStat d_numBuilds;
+    /** Number of equivalence classes assigned a value in the assign phase */
+    IntStat d_numEnumAssigned;
+    /** Number of such equivalence classes whose value from the previous build
+     * was reused */
+    IntStat d_numReused;
+  };
+  Statistics d_statistics;
 }; /* class TheoryEngineModelBuilder */
 
 } /* CVC4::theory namespace */
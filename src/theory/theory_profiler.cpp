@@ -0,0 +1,112 @@
+/*********************                                                        */
+/*! \file theory_profiler.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of per-theory profiling.
+ **/
+
+#include "theory/theory_profiler.h"
+
+#include "smt/smt_statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+TheoryProfiler::Call TheoryProfiler::getCheckCall(Theory::Effort e)
+{
+  switch (e)
+  {
+    case Theory::EFFORT_STANDARD: return CALL_CHECK_STANDARD;
+    case Theory::EFFORT_FULL: return CALL_CHECK_FULL;
+    default: return CALL_CHECK_LAST_CALL;
+  }
+}
+
+const char* TheoryProfiler::toString(Call c)
+{
+  switch (c)
+  {
+    case CALL_CHECK_STANDARD: return "checkStandard";
+    case CALL_CHECK_FULL: return "checkFull";
+    case CALL_CHECK_LAST_CALL: return "checkLastCall";
+    case CALL_PROPAGATE: return "propagate";
+    case CALL_PRE_REGISTER: return "preRegister";
+    case CALL_EXPLAIN: return "explain";
+    default: return "?";
+  }
+}
+
+TheoryProfiler::CallStats::CallStats(const std::string& prefix)
+    : d_calls(prefix + "::calls", 0), d_time(prefix + "::time"), d_count(0)
+{
+  smtStatisticsRegistry()->registerStat(&d_calls);
+  smtStatisticsRegistry()->registerStat(&d_time);
+}
+
+TheoryProfiler::CallStats::~CallStats()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_calls);
+  smtStatisticsRegistry()->unregisterStat(&d_time);
+}
+
+TheoryProfiler::TheoryProfiler(const LogicInfo& logicInfo, uint64_t sampleRate)
+    : d_sampleRate(sampleRate == 0 ? 1 : sampleRate)
+{
+  d_stats.resize(THEORY_LAST * CALL_LAST);
+  for (TheoryId tid = THEORY_FIRST; tid < THEORY_LAST; ++tid)
+  {
+    if (!logicInfo.isTheoryEnabled(tid))
+    {
+      continue;
+    }
+    for (size_t c = 0; c < CALL_LAST; c++)
+    {
+      std::stringstream ss;
+      ss << getStatsPrefix(tid) << "::profile::"
+         << toString(static_cast<Call>(c));
+      d_stats[tid * CALL_LAST + c].reset(new CallStats(ss.str()));
+    }
+  }
+}
+
+TheoryProfiler::~TheoryProfiler() {}
+
+TheoryProfiler::CallStats* TheoryProfiler::beginCall(TheoryId tid, Call c)
+{
+  CallStats* cs = d_stats[tid * CALL_LAST + c].get();
+  if (cs == nullptr)
+  {
+    return nullptr;
+  }
+  ++cs->d_calls;
+  cs->d_count++;
+  // do not time reentrant calls
+  if (cs->d_count % d_sampleRate != 0 || cs->d_time.running())
+  {
+    return nullptr;
+  }
+  cs->d_time.start();
+  return cs;
+}
+
+TheoryProfiler::Scope::Scope(TheoryProfiler* p, TheoryId tid, Call c)
+    : d_timed(p == nullptr ? nullptr : p->beginCall(tid, c))
+{
+}
+
+TheoryProfiler::Scope::~Scope()
+{
+  if (d_timed != nullptr)
+  {
+    d_timed->d_time.stop();
+  }
+}
+
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file theory_profiler.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Per-theory profiling of the calls made by TheoryEngine.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__THEORY_PROFILER_H
+#define CVC4__THEORY__THEORY_PROFILER_H
+
+#include <memory>
+#include <vector>
+
+#include "theory/logic_info.h"
+#include "theory/theory.h"
+#include "theory/theory_id.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+/**
+ * Attributes the calls TheoryEngine makes to each theory, and the time spent
+ * in them, to the theory and the kind of call (--theory-profile).
+ *
+ * For each enabled theory and each kind of call (check at each effort level,
+ * propagate, preRegisterTerm and explain), this class maintains statistics
+ * named
+ *   theory::<theory>::profile::<call>::calls
+ *   theory::<theory>::profile::<call>::time
+ * The former counts all calls. To keep the overhead low, the latter only
+ * accumulates the time spent in every N^th call, where N is given by
+ * --theory-profile-sample. Hence, the total time spent in a kind of call can be
+ * estimated as N times the value of its time statistic. Like all statistics,
+ * these are printed with --stats, and can be queried via
+ * SmtEngine::getStatistic.
+ */
+class TheoryProfiler
+{
+ public:
+  /** The kinds of calls that are profiled */
+  enum Call
+  {
+    CALL_CHECK_STANDARD,
+    CALL_CHECK_FULL,
+    CALL_CHECK_LAST_CALL,
+    CALL_PROPAGATE,
+    CALL_PRE_REGISTER,
+    CALL_EXPLAIN,
+    CALL_LAST
+  };
+  /** Get the kind of call corresponding to checking at effort e */
+  static Call getCheckCall(Theory::Effort e);
+
+ private:
+  /** The statistics for one theory and kind of call */
+  class CallStats
+  {
+   public:
+    CallStats(const std::string& prefix);
+    ~CallStats();
+    /** The number of calls */
+    IntStat d_calls;
+    /** The time spent in the sampled calls */
+    TimerStat d_time;
+    /** The number of calls, used for sampling */
+    uint64_t d_count;
+  };
+
+ public:
+  /**
+   * @param logicInfo The logic, which determines the theories to profile
+   * @param sampleRate We time every sampleRate^th call
+   */
+  TheoryProfiler(const LogicInfo& logicInfo, uint64_t sampleRate);
+  ~TheoryProfiler();
+
+  /**
+   * A scope for profiling a call. The call is counted when the scope is
+   * constructed, and if it is sampled, it is timed until the scope is
+   * destroyed. A scope with a null profiler does nothing.
+   */
+  class Scope
+  {
+   public:
+    Scope(TheoryProfiler* p, TheoryId tid, Call c);
+    ~Scope();
+
+   private:
+    /** The statistics of the call, if we are timing it */
+    CallStats* d_timed;
+  };
+
+ private:
+  /**
+   * Count a call of kind c to theory tid. Returns the statistics of the call
+   * if its timer was started, or nullptr otherwise.
+   */
+  CallStats* beginCall(TheoryId tid, Call c);
+  /** Get the name of the kind of call c, as used in the statistics */
+  static const char* toString(Call c);
+  /** We time every d_sampleRate^th call */
+  uint64_t d_sampleRate;
+  /**
+   * The statistics, where the statistics of call c to theory tid are at
+   * index tid * CALL_LAST + c. Entries for disabled theories are null.
+   */
+  std::vector<std::unique_ptr<CallStats>> d_stats;
+};
+
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__THEORY_PROFILER_H */
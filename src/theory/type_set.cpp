@@ -54,6 +54,13 @@ void TypeSet::add(TypeNode t, TNode n)
   s->insert(n);
 }
 
+void TypeSet::addWithSubTerms(TypeNode t, TNode n)
+{
+  add(t, n);
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  addSubTerms(n, visited);
+}
+
 std::set<Node>* TypeSet::getSet(TypeNode t) const
 {
   const_iterator it = d_typeSet.find(t);
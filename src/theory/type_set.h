@@ -51,6 +51,13 @@ class TypeSet
   void setTypeEnumeratorProperties(TypeEnumeratorProperties* tep);
   /** add node n to the set of values of t */
   void add(TypeNode t, TNode n);
+  /**
+   * Add node n to the set of values of t, and all strict subterms of n to the
+   * sets of values of their types. This is done for all values returned by
+   * nextTypeEnum, and should be used for values that are obtained from
+   * elsewhere but must not be enumerated again by this class.
+   */
+  void addWithSubTerms(TypeNode t, TNode n);
   /** get the set of values of type t */
   std::set<Node>* getSet(TypeNode t) const;
   /** get the next enumerated term of type t
@@ -207,6 +207,17 @@ bool Valuation::needCheck() const{
 
 bool Valuation::isRelevant(Node lit) const { return d_engine->isRelevant(lit); }
 
+bool Valuation::isIrrelevant(Node lit) const
+{
+  return d_engine->isIrrelevant(lit);
+}
+
+bool Valuation::registerLemma(TNode lem, InferenceId id, LemmaProperty p)
+{
+  Assert(d_engine != nullptr);
+  return d_engine->registerLemma(lem, id, p);
+}
+
 context::CDList<Assertion>::const_iterator Valuation::factsBegin(TheoryId tid)
 {
   Theory* theory = d_engine->theoryOf(tid);
@@ -25,6 +25,8 @@
 #include "expr/node.h"
 #include "options/theory_options.h"
 #include "theory/assertion.h"
+#include "theory/inference_id.h"
+#include "theory/output_channel.h"
 
 namespace CVC4 {
 
@@ -203,6 +205,20 @@ public:
    * or during LAST_CALL effort.
    */
   bool isRelevant(Node lit) const;
+  /**
+   * Can the asserted literal lit be skipped by a theory that only checks
+   * relevant literals? Unlike !isRelevant(lit), this returns false for
+   * literals whose atom does not occur in the input formula, e.g. those
+   * introduced by theory lemmas. This call is applicable during FULL or
+   * LAST_CALL effort.
+   */
+  bool isIrrelevant(Node lit) const;
+  /**
+   * Register lemma lem with property p, produced by inference id, with the
+   * global lemma registry of the theory engine. Returns false if lem should
+   * not be sent, since it is a duplicate of a lemma sent by some theory.
+   */
+  bool registerLemma(TNode lem, InferenceId id, LemmaProperty p);
 
   //------------------------------------------- access methods for assertions
   /**
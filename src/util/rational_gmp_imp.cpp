@@ -15,9 +15,11 @@
  **/
 #include "util/rational.h"
 
+#include <climits>
 #include <cmath>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "cvc4autoconfig.h"
 
@@ -91,11 +93,228 @@ Maybe<Rational> Rational::fromDouble(double d)
 {
   using namespace std;
   if(isfinite(d)){
-    Rational q;
-    mpq_set_d(q.d_value.get_mpq_t(), d);
-    return q;
+    mpq_class q;
+    mpq_set_d(q.get_mpq_t(), d);
+    return Rational(q);
   }
   return Maybe<Rational>();
 }
 
+double Rational::getDouble() const
+{
+  // integers of at most 53 bits are exactly representable, everything else
+  // is left to GMP so that we truncate the same way
+  static constexpr int64_t exactBound = static_cast<int64_t>(1) << 53;
+  if (d_big == nullptr && d_den == 1 && d_num < exactBound
+      && d_num > -exactBound)
+  {
+    return static_cast<double>(d_num);
+  }
+  mpq_class tmp;
+  return toMpq(tmp).get_d();
+}
+
+std::string Rational::toString(int base) const
+{
+  if (d_big == nullptr && base == 10)
+  {
+    std::string res = std::to_string(d_num);
+    if (d_den != 1)
+    {
+      res += "/" + std::to_string(d_den);
+    }
+    return res;
+  }
+  mpq_class tmp;
+  return toMpq(tmp).get_str(base);
+}
+
+namespace {
+
+unsigned long absValue(long n)
+{
+  unsigned long res = static_cast<unsigned long>(n);
+  return n < 0 ? 0UL - res : res;
+}
+
+unsigned long gcd(unsigned long a, unsigned long b)
+{
+  while (b != 0)
+  {
+    unsigned long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+}  // namespace
+
+const mpq_class& Rational::toMpq(mpq_class& tmp) const
+{
+  if (d_big != nullptr)
+  {
+    return *d_big;
+  }
+  mpq_set_si(tmp.get_mpq_t(), d_num, static_cast<unsigned long>(d_den));
+  return tmp;
+}
+
+void Rational::setValue(const mpq_class& q)
+{
+  if (mpz_fits_slong_p(q.get_num_mpz_t())
+      && mpz_fits_slong_p(q.get_den_mpz_t()))
+  {
+    d_num = mpz_get_si(q.get_num_mpz_t());
+    d_den = mpz_get_si(q.get_den_mpz_t());
+    d_big.reset();
+    return;
+  }
+  d_num = 0;
+  d_den = 1;
+  if (d_big == nullptr)
+  {
+    d_big.reset(new mpq_class(q));
+  }
+  else
+  {
+    *d_big = q;
+  }
+}
+
+bool Rational::setSmall(bool negative, unsigned long n, unsigned long d)
+{
+  const unsigned long maxLong = static_cast<unsigned long>(LONG_MAX);
+  if (d > maxLong || n > maxLong + (negative ? 1 : 0))
+  {
+    return false;
+  }
+  // written so that LONG_MIN does not overflow
+  d_num = negative ? -static_cast<long>(n - 1) - 1 : static_cast<long>(n);
+  d_den = static_cast<long>(d);
+  d_big.reset();
+  return true;
+}
+
+void Rational::setFraction(long n, long d)
+{
+  if (d != 0)
+  {
+    unsigned long un = absValue(n);
+    unsigned long ud = absValue(d);
+    unsigned long g = gcd(un, ud);
+    if (setSmall(un != 0 && ((n < 0) != (d < 0)), un / g, ud / g))
+    {
+      return;
+    }
+  }
+  // does not fit, or is a division by zero which GMP reports
+  mpq_class q(n, d);
+  q.canonicalize();
+  setValue(q);
+}
+
+void Rational::setFraction(unsigned long n, unsigned long d)
+{
+  if (d != 0)
+  {
+    unsigned long g = gcd(n, d);
+    if (setSmall(false, n / g, d / g))
+    {
+      return;
+    }
+  }
+  mpq_class q(n, d);
+  q.canonicalize();
+  setValue(q);
+}
+
+void Rational::add(const Rational& y, bool subtract)
+{
+  if (d_big == nullptr && y.d_big == nullptr)
+  {
+    // a/b + c/d = (a*(d/g) + c*(b/g)) / (b*(d/g)) where g = gcd(b, d)
+    long g = static_cast<long>(gcd(d_den, y.d_den));
+    long bg = d_den / g;
+    long dg = y.d_den / g;
+    long l, r, n, den;
+    if (!__builtin_mul_overflow(d_num, dg, &l)
+        && !__builtin_mul_overflow(y.d_num, bg, &r)
+        && !(subtract ? __builtin_sub_overflow(l, r, &n)
+                      : __builtin_add_overflow(l, r, &n))
+        && !__builtin_mul_overflow(d_den, dg, &den))
+    {
+      unsigned long un = absValue(n);
+      unsigned long ud = static_cast<unsigned long>(den);
+      unsigned long h = gcd(un, ud);
+      if (setSmall(n < 0, un / h, ud / h))
+      {
+        return;
+      }
+    }
+  }
+  mpq_class ta, tb, res;
+  const mpq_class& a = toMpq(ta);
+  const mpq_class& b = y.toMpq(tb);
+  if (subtract)
+  {
+    mpq_sub(res.get_mpq_t(), a.get_mpq_t(), b.get_mpq_t());
+  }
+  else
+  {
+    mpq_add(res.get_mpq_t(), a.get_mpq_t(), b.get_mpq_t());
+  }
+  setValue(res);
+}
+
+void Rational::mul(const Rational& y, bool divide)
+{
+  if (d_big == nullptr && y.d_big == nullptr && !(divide && y.d_num == 0))
+  {
+    if (d_num == 0 || y.d_num == 0)
+    {
+      setSmall(false, 0, 1);
+      return;
+    }
+    // (a/b) * (c/d) = ((a/g1) * (c/g2)) / ((b/g2) * (d/g1)) where
+    // g1 = gcd(a, d) and g2 = gcd(c, b), with c and d swapped for division
+    unsigned long a = absValue(d_num);
+    unsigned long b = static_cast<unsigned long>(d_den);
+    unsigned long c = static_cast<unsigned long>(y.d_den);
+    unsigned long d = absValue(y.d_num);
+    if (!divide)
+    {
+      std::swap(c, d);
+    }
+    unsigned long g1 = gcd(a, d);
+    unsigned long g2 = gcd(c, b);
+    unsigned long n, den;
+    if (!__builtin_mul_overflow(a / g1, c / g2, &n)
+        && !__builtin_mul_overflow(b / g2, d / g1, &den)
+        && setSmall((d_num < 0) != (y.d_num < 0), n, den))
+    {
+      return;
+    }
+  }
+  mpq_class ta, tb, res;
+  const mpq_class& a = toMpq(ta);
+  const mpq_class& b = y.toMpq(tb);
+  if (divide)
+  {
+    mpq_div(res.get_mpq_t(), a.get_mpq_t(), b.get_mpq_t());
+  }
+  else
+  {
+    mpq_mul(res.get_mpq_t(), a.get_mpq_t(), b.get_mpq_t());
+  }
+  setValue(res);
+}
+
+int Rational::cmpSlow(const Rational& x) const
+{
+  mpq_class ta, tb;
+  int res = mpq_cmp(toMpq(ta).get_mpq_t(), x.toMpq(tb).get_mpq_t());
+  return res < 0 ? -1 : (res == 0 ? 0 : 1);
+}
+
 } /* namespace CVC4 */
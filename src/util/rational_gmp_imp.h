@@ -22,6 +22,8 @@
 
 #include <gmp.h>
 
+#include <climits>
+#include <memory>
 #include <string>
 
 #include "util/gmp_util.h"
@@ -39,6 +41,12 @@ namespace CVC4 {
  ** literature.) A consequence is that that the numerator and denominator may be
  ** different than the values used to construct the Rational.
  **
+ ** Rationals whose numerator and denominator both fit into a signed long are
+ ** stored inline as a pair of machine integers and all arithmetic on them is
+ ** done with overflow-checked machine arithmetic. A GMP rational is only
+ ** allocated once a value no longer fits, and results that fit again are
+ ** stored inline. Hence every value has exactly one representation.
+ **
  ** NOTE: The correct way to create a Rational from an int is to use one of the
  ** int numerator/int denominator constructors with the denominator 1.  Trying
  ** to construct a Rational with a single int, e.g., Rational(0), will put you
@@ -54,7 +62,7 @@ class CVC4_PUBLIC Rational
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {}
+  Rational(const mpq_class& val) : d_num(0), d_den(1) { setValue(val); }
 
   /**
    * Creates a rational from a decimal string (e.g., <code>"1.5"</code>).
@@ -65,7 +73,7 @@ class CVC4_PUBLIC Rational
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0) { d_value.canonicalize(); }
+  Rational() : d_num(0), d_den(1) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -74,96 +82,140 @@ class CVC4_PUBLIC Rational
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10) : d_value(s, base)
+  explicit Rational(const char* s, unsigned base = 10) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    mpq_class q(s, base);
+    q.canonicalize();
+    setValue(q);
   }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base)
+  Rational(const std::string& s, unsigned base = 10) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    mpq_class q(s, base);
+    q.canonicalize();
+    setValue(q);
   }
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) { d_value.canonicalize(); }
+  Rational(const Rational& q) : d_num(q.d_num), d_den(q.d_den)
+  {
+    if (q.d_big != nullptr)
+    {
+      d_big.reset(new mpq_class(*q.d_big));
+    }
+  }
+  Rational(Rational&& q) = default;
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(signed long int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned long int n) : d_value(n, 1) { d_value.canonicalize(); }
-
-#ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1)
-  {
-    d_value.canonicalize();
-  }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1)
+  Rational(signed int n) : d_num(n), d_den(1) {}
+  Rational(unsigned int n) : Rational(static_cast<unsigned long>(n)) {}
+  Rational(signed long int n) : d_num(n), d_den(1) {}
+  Rational(unsigned long int n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    if (n <= static_cast<unsigned long>(LONG_MAX))
+    {
+      d_num = static_cast<long>(n);
+    }
+    else
+    {
+      setValue(mpq_class(n));
+    }
   }
+
+#ifdef CVC4_NEED_INT64_T_OVERLOADS
+  Rational(int64_t n) : Rational(static_cast<long>(n)) {}
+  Rational(uint64_t n) : Rational(static_cast<unsigned long>(n)) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n, d)
+  Rational(signed int n, signed int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(static_cast<long>(n), static_cast<long>(d));
   }
-  Rational(unsigned int n, unsigned int d) : d_value(n, d)
+  Rational(unsigned int n, unsigned int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(static_cast<unsigned long>(n), static_cast<unsigned long>(d));
   }
-  Rational(signed long int n, signed long int d) : d_value(n, d)
+  Rational(signed long int n, signed long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n, d)
+  Rational(unsigned long int n, unsigned long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
   Rational(int64_t n, int64_t d)
-      : d_value(static_cast<long>(n), static_cast<long>(d))
+      : Rational(static_cast<long>(n), static_cast<long>(d))
   {
-    d_value.canonicalize();
   }
   Rational(uint64_t n, uint64_t d)
-      : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
+      : Rational(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
   {
-    d_value.canonicalize();
   }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d)
-      : d_value(n.get_mpz(), d.get_mpz())
+  Rational(const Integer& n, const Integer& d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    if (n.fitsSignedLong() && d.fitsSignedLong())
+    {
+      setFraction(n.getLong(), d.getLong());
+    }
+    else
+    {
+      mpq_class q(n.get_mpz(), d.get_mpz());
+      q.canonicalize();
+      setValue(q);
+    }
+  }
+  Rational(const Integer& n) : d_num(0), d_den(1)
+  {
+    if (n.fitsSignedLong())
+    {
+      d_num = n.getLong();
+    }
+    else
+    {
+      setValue(mpq_class(n.get_mpz()));
+    }
   }
-  Rational(const Integer& n) : d_value(n.get_mpz()) { d_value.canonicalize(); }
   ~Rational() {}
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns a copy of the value as a GMP rational.
    */
-  const mpq_class& getValue() const { return d_value; }
+  mpq_class getValue() const
+  {
+    if (d_big != nullptr)
+    {
+      return *d_big;
+    }
+    return mpq_class(d_num, d_den);
+  }
 
   /**
    * Returns the value of numerator of the Rational.
    * Note that this makes a deep copy of the numerator.
    */
-  Integer getNumerator() const { return Integer(d_value.get_num()); }
+  Integer getNumerator() const
+  {
+    return d_big == nullptr ? Integer(d_num) : Integer(d_big->get_num());
+  }
 
   /**
    * Returns the value of denominator of the Rational.
    * Note that this makes a deep copy of the denominator.
    */
-  Integer getDenominator() const { return Integer(d_value.get_den()); }
+  Integer getDenominator() const
+  {
+    return d_big == nullptr ? Integer(d_den) : Integer(d_big->get_den());
+  }
 
   static Maybe<Rational> fromDouble(double d);
 
@@ -172,7 +224,7 @@ class CVC4_PUBLIC Rational
    * approximate: truncation may occur, overflow may result in
    * infinity, and underflow may result in zero.
    */
-  double getDouble() const { return d_value.get_d(); }
+  double getDouble() const;
 
   Rational inverse() const
   {
@@ -181,20 +233,36 @@ class CVC4_PUBLIC Rational
 
   int cmp(const Rational& x) const
   {
-    // Don't use mpq_class's cmp() function.
-    // The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    if (d_big == nullptr && x.d_big == nullptr)
+    {
+      long l = d_num;
+      long r = x.d_num;
+      if (d_den == x.d_den
+          || (!__builtin_mul_overflow(d_num, x.d_den, &l)
+              && !__builtin_mul_overflow(x.d_num, d_den, &r)))
+      {
+        return l < r ? -1 : (l == r ? 0 : 1);
+      }
+    }
+    return cmpSlow(x);
   }
 
-  int sgn() const { return mpq_sgn(d_value.get_mpq_t()); }
+  int sgn() const
+  {
+    if (d_big == nullptr)
+    {
+      return d_num < 0 ? -1 : (d_num == 0 ? 0 : 1);
+    }
+    return mpq_sgn(d_big->get_mpq_t());
+  }
 
-  bool isZero() const { return sgn() == 0; }
+  bool isZero() const { return d_big == nullptr && d_num == 0; }
 
-  bool isOne() const { return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0; }
+  bool isOne() const { return d_big == nullptr && d_num == 1 && d_den == 1; }
 
   bool isNegativeOne() const
   {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
+    return d_big == nullptr && d_num == -1 && d_den == 1;
   }
 
   Rational abs() const
@@ -211,15 +279,26 @@ class CVC4_PUBLIC Rational
 
   Integer floor() const
   {
+    if (d_big == nullptr)
+    {
+      // division truncates towards zero, and d_den > 1 if not integral
+      long q = d_num / d_den;
+      return Integer(d_num < 0 && d_den != 1 ? q - 1 : q);
+    }
     mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_fdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
     return Integer(q);
   }
 
   Integer ceiling() const
   {
+    if (d_big == nullptr)
+    {
+      long q = d_num / d_den;
+      return Integer(d_num > 0 && d_den != 1 ? q + 1 : q);
+    }
     mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_cdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
     return Integer(q);
   }
 
@@ -228,69 +307,144 @@ class CVC4_PUBLIC Rational
   Rational& operator=(const Rational& x)
   {
     if (this == &x) return *this;
-    d_value = x.d_value;
+    d_num = x.d_num;
+    d_den = x.d_den;
+    if (x.d_big == nullptr)
+    {
+      d_big.reset();
+    }
+    else if (d_big == nullptr)
+    {
+      d_big.reset(new mpq_class(*x.d_big));
+    }
+    else
+    {
+      *d_big = *x.d_big;
+    }
     return *this;
   }
+  Rational& operator=(Rational&& x) = default;
 
-  Rational operator-() const { return Rational(-(d_value)); }
+  Rational operator-() const
+  {
+    long n;
+    if (d_big == nullptr && !__builtin_sub_overflow(0L, d_num, &n))
+    {
+      Rational r;
+      r.d_num = n;
+      r.d_den = d_den;
+      return r;
+    }
+    return Rational(-getValue());
+  }
 
-  bool operator==(const Rational& y) const { return d_value == y.d_value; }
+  bool operator==(const Rational& y) const
+  {
+    if (d_big == nullptr || y.d_big == nullptr)
+    {
+      // the representation is unique
+      return d_big == y.d_big && d_num == y.d_num && d_den == y.d_den;
+    }
+    return *d_big == *y.d_big;
+  }
 
-  bool operator!=(const Rational& y) const { return d_value != y.d_value; }
+  bool operator!=(const Rational& y) const { return !(*this == y); }
 
-  bool operator<(const Rational& y) const { return d_value < y.d_value; }
+  bool operator<(const Rational& y) const { return cmp(y) < 0; }
 
-  bool operator<=(const Rational& y) const { return d_value <= y.d_value; }
+  bool operator<=(const Rational& y) const { return cmp(y) <= 0; }
 
-  bool operator>(const Rational& y) const { return d_value > y.d_value; }
+  bool operator>(const Rational& y) const { return cmp(y) > 0; }
 
-  bool operator>=(const Rational& y) const { return d_value >= y.d_value; }
+  bool operator>=(const Rational& y) const { return cmp(y) >= 0; }
 
   Rational operator+(const Rational& y) const
   {
-    return Rational(d_value + y.d_value);
+    Rational r(*this);
+    r += y;
+    return r;
   }
   Rational operator-(const Rational& y) const
   {
-    return Rational(d_value - y.d_value);
+    Rational r(*this);
+    r -= y;
+    return r;
   }
 
   Rational operator*(const Rational& y) const
   {
-    return Rational(d_value * y.d_value);
+    Rational r(*this);
+    r *= y;
+    return r;
   }
   Rational operator/(const Rational& y) const
   {
-    return Rational(d_value / y.d_value);
+    Rational r(*this);
+    r /= y;
+    return r;
   }
 
   Rational& operator+=(const Rational& y)
   {
-    d_value += y.d_value;
+    long n;
+    if (isSmallIntegral() && y.isSmallIntegral()
+        && !__builtin_add_overflow(d_num, y.d_num, &n))
+    {
+      d_num = n;
+    }
+    else
+    {
+      add(y, false);
+    }
     return (*this);
   }
   Rational& operator-=(const Rational& y)
   {
-    d_value -= y.d_value;
+    long n;
+    if (isSmallIntegral() && y.isSmallIntegral()
+        && !__builtin_sub_overflow(d_num, y.d_num, &n))
+    {
+      d_num = n;
+    }
+    else
+    {
+      add(y, true);
+    }
     return (*this);
   }
 
   Rational& operator*=(const Rational& y)
   {
-    d_value *= y.d_value;
+    long n;
+    if (isSmallIntegral() && y.isSmallIntegral()
+        && !__builtin_mul_overflow(d_num, y.d_num, &n))
+    {
+      d_num = n;
+    }
+    else
+    {
+      mul(y, false);
+    }
     return (*this);
   }
 
   Rational& operator/=(const Rational& y)
   {
-    d_value /= y.d_value;
+    mul(y, true);
     return (*this);
   }
 
-  bool isIntegral() const { return getDenominator() == 1; }
+  bool isIntegral() const
+  {
+    if (d_big == nullptr)
+    {
+      return d_den == 1;
+    }
+    return mpz_cmp_ui(d_big->get_den_mpz_t(), 1) == 0;
+  }
 
   /** Returns a string representing the rational in the given base. */
-  std::string toString(int base = 10) const { return d_value.get_str(base); }
+  std::string toString(int base = 10) const;
 
   /**
    * Computes the hash of the rational from hashes of the numerator and the
@@ -298,8 +452,18 @@ class CVC4_PUBLIC Rational
    */
   size_t hash() const
   {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
+    if (d_big == nullptr)
+    {
+      // agrees with gmpz_hash on single limb values
+      unsigned long absNum = static_cast<unsigned long>(d_num);
+      if (d_num < 0)
+      {
+        absNum = 0UL - absNum;
+      }
+      return static_cast<size_t>(absNum) xor static_cast<size_t>(d_den);
+    }
+    size_t numeratorHash = gmpz_hash(d_big->get_num_mpz_t());
+    size_t denominatorHash = gmpz_hash(d_big->get_den_mpz_t());
 
     return numeratorHash xor denominatorHash;
   }
@@ -315,11 +479,42 @@ class CVC4_PUBLIC Rational
   int absCmp(const Rational& q) const;
 
  private:
+  /** Is this an integer that is stored inline? */
+  bool isSmallIntegral() const { return d_big == nullptr && d_den == 1; }
+  /**
+   * Returns this value as a GMP rational, using tmp as storage if it is stored
+   * inline.
+   */
+  const mpq_class& toMpq(mpq_class& tmp) const;
+  /** Sets this to the canonical rational q. */
+  void setValue(const mpq_class& q);
+  /**
+   * Sets this to n/d if both fit inline, where n and d are coprime and the
+   * sign of the value is given by negative. Returns false otherwise.
+   */
+  bool setSmall(bool negative, unsigned long n, unsigned long d);
+  /** Sets this to the canonical form of n/d. */
+  void setFraction(long n, long d);
+  void setFraction(unsigned long n, unsigned long d);
+  /** Adds (or subtracts if subtract is true) y to this. */
+  void add(const Rational& y, bool subtract);
+  /** Multiplies (or divides if divide is true) this by y. */
+  void mul(const Rational& y, bool divide);
+  /** Compares to x on GMP rationals. */
+  int cmpSlow(const Rational& x) const;
+
+  /**
+   * The numerator and denominator of the rational if it is stored inline. The
+   * denominator is positive and coprime to the numerator. If d_big is set,
+   * these are 0 and 1.
+   */
+  long d_num;
+  long d_den;
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * Stores the value of the rational in a C++ GMP rational class if it does
+   * not fit inline, and is null otherwise.
    */
-  mpq_class d_value;
+  std::unique_ptr<mpq_class> d_big;
 
 }; /* class Rational */
 
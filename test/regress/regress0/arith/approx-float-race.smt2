@@ -0,0 +1,26 @@
+; COMMAND-LINE: --approx-float --approx-float-race --incremental --standard-effort-variable-order-pivots=1 --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(z::approx::float::race::runs\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT-ERROR: z::approx::float::race::runs > 0
+(set-logic QF_LRA)
+; Four rows are violated initially, so pass1 with a single pivot leaves the
+; relaxation unknown and the two pivot rules are raced.
+(declare-fun a () Real)
+(declare-fun b () Real)
+(declare-fun c () Real)
+(declare-fun d () Real)
+(declare-fun e () Real)
+(assert (>= (+ a b) 4))
+(assert (>= (- c d) 2))
+(assert (>= (+ (* 2 e) a) 3))
+(assert (>= (- b e) 1))
+(assert (<= (+ a b c d e) 20))
+(assert (>= a 0))
+(assert (>= d 0))
+(check-sat)
+(push 1)
+(assert (<= (+ a b c) 5))
+(check-sat)
+(pop 1)
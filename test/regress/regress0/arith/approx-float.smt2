@@ -0,0 +1,27 @@
+; COMMAND-LINE: --approx-float --incremental --standard-effort-variable-order-pivots=1 --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(z::approx::float::pivots\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT-ERROR: z::approx::float::pivots > 0
+(set-logic QF_LRA)
+; Three rows are violated initially, so pass1 with a single pivot leaves the
+; relaxation unknown and the floating-point simplex runs.
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+(assert (<= (+ x y z) 10.5))
+(assert (>= (+ (* 2 x) (- y) w) 3))
+(assert (>= (- z (* 3 w)) (/ 1 3)))
+(assert (< (+ x (* 4 w)) 7))
+(assert (> (+ y z) 2))
+(assert (>= x 0))
+(assert (>= w (- 1)))
+(check-sat)
+(push 1)
+(assert (> (+ (* 3 x) (* 2 y) (* 4 z) (- w)) 100))
+(assert (<= y 0))
+(assert (<= z 1))
+(check-sat)
+(pop 1)
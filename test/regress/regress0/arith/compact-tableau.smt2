@@ -0,0 +1,94 @@
+; COMMAND-LINE: --incremental --arith-compact-tableau --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::arith::compactions\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT-ERROR: theory::arith::compactions > 0
+; Dense rows with tight bounds around a known solution, so that the
+; simplex pivots often enough for the tableau to be compacted.
+(set-logic QF_LRA)
+(declare-fun x0 () Real)
+(declare-fun x1 () Real)
+(declare-fun x2 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(declare-fun x6 () Real)
+(declare-fun x7 () Real)
+(declare-fun x8 () Real)
+(declare-fun x9 () Real)
+(declare-fun x10 () Real)
+(declare-fun x11 () Real)
+(declare-fun x12 () Real)
+(declare-fun x13 () Real)
+(declare-fun x14 () Real)
+(declare-fun x15 () Real)
+(declare-fun x16 () Real)
+(declare-fun x17 () Real)
+(declare-fun x18 () Real)
+(declare-fun x19 () Real)
+(declare-fun x20 () Real)
+(declare-fun x21 () Real)
+(declare-fun x22 () Real)
+(declare-fun x23 () Real)
+(declare-fun x24 () Real)
+(assert (<= 72 (+ (* 5 x0) (* (- 3) x1) (* (- 2) x2) (* (- 1) x3) (* 3 x4) (* 4 x5) (* 4 x6) (* (- 3) x7) (* 5 x8) (* 4 x9) (* 1 x10) (* 4 x11) (* 3 x12) (* 3 x13) (* (- 1) x14) (* (- 4) x15) (* (- 1) x16) (* 2 x17) (* (- 1) x18) (* 4 x19) (* 3 x20) (* (- 5) x21) (* 5 x22) (* 2 x23) (* (- 1) x24)) 74))
+(assert (<= (- 26) (+ (* 1 x0) (* 4 x1) (* (- 2) x2) (* (- 4) x3) (* (- 5) x4) (* 1 x5) (* (- 1) x6) (* (- 2) x7) (* (- 4) x8) (* 1 x9) (* (- 4) x10) (* 1 x11) (* (- 2) x12) (* 4 x13) (* (- 1) x14) (* 1 x15) (* (- 5) x16) (* 1 x17) (* 4 x18) (* (- 1) x19) (* 4 x20) (* 2 x21) (* 2 x22) (* (- 3) x23) (* (- 4) x24)) (- 24)))
+(assert (<= 10 (+ (* (- 5) x0) (* 1 x1) (* 4 x2) (* (- 4) x3) (* (- 4) x4) (* (- 3) x5) (* (- 4) x6) (* (- 4) x7) (* 1 x8) (* (- 5) x9) (* (- 5) x10) (* 2 x11) (* (- 1) x12) (* 1 x13) (* (- 2) x14) (* (- 2) x15) (* 2 x16) (* 3 x17) (* 5 x18) (* 3 x19) (* 1 x20) (* 5 x21) (* 4 x22) (* 3 x23) (* (- 1) x24)) 12))
+(assert (<= 5 (+ (* 3 x0) (* (- 4) x1) (* (- 5) x2) (* 3 x3) (* 2 x4) (* 2 x5) (* 1 x6) (* (- 4) x7) (* (- 2) x8) (* (- 5) x9) (* 4 x10) (* 3 x11) (* 1 x12) (* (- 3) x13) (* 3 x14) (* 5 x15) (* 3 x16) (* (- 5) x17) (* (- 4) x18) (* 5 x19) (* (- 1) x20) (* 3 x21) (* (- 1) x22) (* 2 x23) (* 4 x24)) 7))
+(assert (<= 57 (+ (* 2 x0) (* (- 1) x1) (* 3 x2) (* 5 x3) (* 3 x4) (* 2 x5) (* (- 5) x6) (* 2 x7) (* 1 x8) (* 1 x9) (* (- 3) x10) (* (- 4) x11) (* (- 3) x12) (* 1 x13) (* 5 x14) (* (- 1) x15) (* 5 x16) (* (- 3) x17) (* 1 x18) (* 2 x19) (* 2 x20) (* 1 x21) (* 1 x22) (* 5 x23) (* 4 x24)) 59))
+(assert (<= (- 32) (+ (* (- 5) x0) (* (- 5) x1) (* (- 2) x2) (* 3 x3) (* (- 4) x4) (* (- 1) x5) (* 5 x6) (* (- 4) x7) (* 5 x8) (* (- 4) x9) (* (- 2) x10) (* (- 2) x11) (* (- 2) x12) (* 5 x13) (* (- 4) x14) (* (- 4) x15) (* (- 5) x16) (* 5 x17) (* 2 x18) (* 4 x19) (* 1 x20) (* (- 5) x21) (* (- 3) x22) (* 2 x23) (* (- 5) x24)) (- 30)))
+(assert (<= (- 4) (+ (* (- 4) x0) (* (- 3) x1) (* 3 x2) (* (- 5) x3) (* (- 5) x4) (* 5 x5) (* (- 2) x6) (* 4 x7) (* (- 2) x8) (* (- 4) x9) (* 1 x10) (* 1 x11) (* (- 4) x12) (* 3 x13) (* (- 1) x14) (* (- 5) x15) (* (- 5) x16) (* (- 5) x17) (* 3 x18) (* (- 1) x19) (* 5 x20) (* 1 x21) (* 1 x22) (* 4 x23) (* (- 3) x24)) (- 2)))
+(assert (<= (- 6) (+ (* 1 x0) (* (- 4) x1) (* 1 x2) (* 2 x3) (* 3 x4) (* 3 x5) (* (- 1) x6) (* (- 2) x7) (* (- 4) x8) (* 4 x9) (* (- 2) x10) (* (- 3) x11) (* (- 1) x12) (* (- 4) x13) (* (- 3) x14) (* 2 x15) (* 4 x16) (* (- 3) x17) (* (- 3) x18) (* 3 x19) (* 4 x20) (* 3 x21) (* 3 x22) (* 1 x23) (* (- 2) x24)) (- 4)))
+(assert (<= (- 20) (+ (* (- 5) x0) (* (- 5) x1) (* (- 5) x2) (* (- 4) x3) (* (- 3) x4) (* 1 x5) (* (- 3) x6) (* 1 x7) (* (- 1) x8) (* (- 2) x9) (* (- 1) x10) (* 5 x11) (* (- 5) x12) (* 3 x13) (* 3 x14) (* 5 x15) (* 2 x16) (* 5 x17) (* (- 1) x18) (* (- 1) x19) (* (- 2) x20) (* (- 5) x21) (* (- 1) x22) (* (- 3) x23) (* 2 x24)) (- 18)))
+(assert (<= (- 25) (+ (* (- 5) x0) (* 1 x1) (* (- 4) x2) (* (- 4) x3) (* (- 2) x4) (* 2 x5) (* 1 x6) (* (- 2) x7) (* 2 x8) (* (- 5) x9) (* (- 2) x10) (* (- 3) x11) (* 4 x12) (* (- 3) x13) (* 2 x14) (* 5 x15) (* (- 4) x16) (* 5 x17) (* 3 x18) (* (- 2) x19) (* (- 2) x20) (* 2 x21) (* (- 1) x22) (* (- 1) x23) (* 2 x24)) (- 23)))
+(assert (<= (- 29) (+ (* (- 1) x0) (* 2 x1) (* (- 2) x2) (* 5 x3) (* 2 x4) (* 3 x5) (* 3 x6) (* 2 x7) (* (- 4) x8) (* 1 x9) (* 3 x10) (* (- 3) x11) (* (- 1) x12) (* (- 2) x13) (* (- 5) x14) (* (- 4) x15) (* (- 3) x16) (* (- 3) x17) (* 2 x18) (* 1 x19) (* 3 x20) (* (- 3) x21) (* 2 x22) (* (- 3) x23) (* (- 2) x24)) (- 27)))
+(assert (<= 50 (+ (* (- 4) x0) (* (- 3) x1) (* 4 x2) (* 2 x3) (* (- 3) x4) (* 5 x5) (* 4 x6) (* (- 4) x7) (* 2 x8) (* (- 4) x9) (* 5 x10) (* 4 x11) (* 3 x12) (* 2 x13) (* (- 5) x14) (* 5 x15) (* (- 4) x16) (* 3 x17) (* 3 x18) (* (- 2) x19) (* 4 x20) (* (- 1) x21) (* (- 3) x22) (* 4 x23) (* 4 x24)) 52))
+(assert (<= 10 (+ (* 2 x0) (* (- 1) x1) (* 5 x2) (* 3 x3) (* (- 2) x4) (* 2 x5) (* (- 1) x6) (* (- 5) x7) (* (- 1) x8) (* (- 3) x9) (* 3 x10) (* (- 1) x11) (* (- 5) x12) (* (- 1) x13) (* (- 1) x14) (* (- 2) x15) (* (- 1) x16) (* 3 x17) (* (- 5) x18) (* (- 2) x19) (* (- 1) x20) (* 5 x21) (* 2 x22) (* 4 x23) (* 1 x24)) 12))
+(assert (<= (- 39) (+ (* 1 x0) (* (- 4) x1) (* (- 2) x2) (* (- 5) x3) (* 2 x4) (* 1 x5) (* (- 2) x6) (* 4 x7) (* (- 1) x8) (* 5 x9) (* 5 x10) (* 1 x11) (* (- 1) x12) (* 1 x13) (* (- 5) x14) (* (- 1) x15) (* (- 4) x16) (* (- 3) x17) (* 4 x18) (* (- 2) x19) (* (- 5) x20) (* (- 1) x21) (* (- 5) x22) (* 2 x23) (* 4 x24)) (- 37)))
+(assert (<= 18 (+ (* 1 x0) (* 1 x1) (* (- 4) x2) (* 2 x3) (* 4 x4) (* 1 x5) (* (- 1) x6) (* 1 x7) (* (- 2) x8) (* (- 5) x9) (* 5 x10) (* (- 5) x11) (* 4 x12) (* 4 x13) (* 3 x14) (* (- 4) x15) (* (- 1) x16) (* 3 x17) (* (- 1) x18) (* (- 4) x19) (* 1 x20) (* 2 x21) (* 5 x22) (* 1 x23) (* (- 3) x24)) 20))
+(assert (<= (- 7) (+ (* 2 x0) (* (- 3) x1) (* (- 1) x2) (* (- 3) x3) (* (- 3) x4) (* 3 x5) (* 1 x6) (* 1 x7) (* (- 1) x8) (* (- 1) x9) (* (- 1) x10) (* 1 x11) (* 5 x12) (* (- 5) x13) (* (- 1) x14) (* (- 3) x15) (* 5 x16) (* (- 4) x17) (* 2 x18) (* 4 x19) (* 5 x20) (* 1 x21) (* (- 3) x22) (* (- 3) x23) (* 3 x24)) (- 5)))
+(assert (<= 48 (+ (* (- 3) x0) (* 2 x1) (* (- 2) x2) (* (- 3) x3) (* (- 1) x4) (* 5 x5) (* (- 3) x6) (* 2 x7) (* 4 x8) (* (- 2) x9) (* 3 x10) (* (- 4) x11) (* (- 5) x12) (* 5 x13) (* 5 x14) (* (- 2) x15) (* (- 3) x16) (* 1 x17) (* 4 x18) (* (- 1) x19) (* 5 x20) (* 1 x21) (* 3 x22) (* 1 x23) (* (- 3) x24)) 50))
+(assert (<= 16 (+ (* (- 1) x0) (* (- 3) x1) (* (- 4) x2) (* (- 4) x3) (* 4 x4) (* (- 4) x5) (* (- 5) x6) (* (- 3) x7) (* (- 3) x8) (* 4 x9) (* 2 x10) (* 4 x11) (* (- 4) x12) (* 3 x13) (* 5 x14) (* (- 2) x15) (* (- 5) x16) (* 5 x17) (* 5 x18) (* 4 x19) (* 2 x20) (* 2 x21) (* (- 5) x22) (* 4 x23) (* 1 x24)) 18))
+(assert (<= (- 51) (+ (* (- 5) x0) (* 3 x1) (* (- 4) x2) (* (- 2) x3) (* (- 3) x4) (* (- 3) x5) (* 3 x6) (* (- 1) x7) (* 1 x8) (* 1 x9) (* (- 2) x10) (* 4 x11) (* (- 3) x12) (* (- 2) x13) (* 5 x14) (* (- 3) x15) (* (- 2) x16) (* (- 4) x17) (* 1 x18) (* 4 x19) (* (- 2) x20) (* (- 3) x21) (* (- 5) x22) (* (- 4) x23) (* (- 2) x24)) (- 49)))
+(assert (<= (- 17) (+ (* (- 2) x0) (* 4 x1) (* 2 x2) (* 3 x3) (* 3 x4) (* (- 4) x5) (* 5 x6) (* 1 x7) (* (- 1) x8) (* 2 x9) (* 1 x10) (* 4 x11) (* 4 x12) (* (- 5) x13) (* (- 4) x14) (* (- 2) x15) (* 1 x16) (* (- 3) x17) (* (- 1) x18) (* (- 2) x19) (* (- 2) x20) (* (- 4) x21) (* (- 4) x22) (* 1 x23) (* 2 x24)) (- 15)))
+(assert (<= (- 10) (+ (* (- 3) x0) (* 4 x1) (* (- 5) x2) (* 4 x3) (* 5 x4) (* (- 4) x5) (* (- 5) x6) (* 2 x7) (* 4 x8) (* 2 x9) (* 1 x10) (* (- 1) x11) (* 1 x12) (* 2 x13) (* 1 x14) (* (- 2) x15) (* 4 x16) (* (- 4) x17) (* 4 x18) (* 1 x19) (* 2 x20) (* (- 3) x21) (* (- 4) x22) (* (- 5) x23) (* (- 1) x24)) (- 8)))
+(assert (<= 42 (+ (* 4 x0) (* (- 1) x1) (* (- 5) x2) (* 4 x3) (* (- 3) x4) (* 5 x5) (* 3 x6) (* 2 x7) (* 3 x8) (* 2 x9) (* (- 1) x10) (* 3 x11) (* (- 4) x12) (* (- 2) x13) (* 2 x14) (* 5 x15) (* 4 x16) (* 2 x17) (* 2 x18) (* (- 3) x19) (* 1 x20) (* (- 5) x21) (* (- 3) x22) (* 4 x23) (* 1 x24)) 44))
+(assert (<= 3 (+ (* 1 x0) (* 2 x1) (* 1 x2) (* 5 x3) (* (- 1) x4) (* (- 4) x5) (* (- 1) x6) (* (- 1) x7) (* 1 x8) (* 1 x9) (* (- 2) x10) (* (- 3) x11) (* (- 1) x12) (* 5 x13) (* (- 5) x14) (* 2 x15) (* 4 x16) (* (- 2) x17) (* (- 2) x18) (* 4 x19) (* 4 x20) (* (- 4) x21) (* (- 2) x22) (* 4 x23) (* (- 3) x24)) 5))
+(assert (<= 34 (+ (* 4 x0) (* 4 x1) (* 4 x2) (* (- 1) x3) (* (- 1) x4) (* 5 x5) (* (- 2) x6) (* (- 3) x7) (* (- 5) x8) (* 2 x9) (* 5 x10) (* 1 x11) (* 2 x12) (* 5 x13) (* (- 3) x14) (* 5 x15) (* 2 x16) (* 1 x17) (* (- 5) x18) (* (- 5) x19) (* 3 x20) (* 5 x21) (* (- 3) x22) (* 1 x23) (* (- 4) x24)) 36))
+(assert (<= (- 26) (+ (* 1 x0) (* (- 2) x1) (* (- 3) x2) (* 3 x3) (* 5 x4) (* 1 x5) (* (- 5) x6) (* 5 x7) (* (- 5) x8) (* 3 x9) (* 1 x10) (* (- 1) x11) (* (- 3) x12) (* (- 1) x13) (* 4 x14) (* 1 x15) (* (- 3) x16) (* 3 x17) (* 2 x18) (* (- 3) x19) (* (- 5) x20) (* 3 x21) (* (- 5) x22) (* (- 1) x23) (* (- 3) x24)) (- 24)))
+(assert (<= (- 46) (+ (* 1 x0) (* (- 4) x1) (* 3 x2) (* (- 4) x3) (* (- 5) x4) (* (- 2) x5) (* 5 x6) (* (- 4) x7) (* (- 3) x8) (* (- 4) x9) (* (- 4) x10) (* 3 x11) (* (- 4) x12) (* 1 x13) (* (- 3) x14) (* 1 x15) (* (- 5) x16) (* 3 x17) (* (- 3) x18) (* 3 x19) (* 5 x20) (* (- 5) x21) (* (- 5) x22) (* (- 3) x23) (* 5 x24)) (- 44)))
+(assert (<= 79 (+ (* (- 3) x0) (* 4 x1) (* 2 x2) (* 5 x3) (* (- 3) x4) (* 5 x5) (* (- 4) x6) (* (- 1) x7) (* 4 x8) (* 3 x9) (* (- 3) x10) (* 3 x11) (* 3 x12) (* 5 x13) (* 2 x14) (* 1 x15) (* 4 x16) (* 3 x17) (* 2 x18) (* (- 4) x19) (* 3 x20) (* (- 3) x21) (* 5 x22) (* (- 2) x23) (* 2 x24)) 81))
+(assert (<= 23 (+ (* 1 x0) (* (- 1) x1) (* 4 x2) (* 2 x3) (* (- 2) x4) (* 4 x5) (* (- 3) x6) (* 1 x7) (* 4 x8) (* 1 x9) (* (- 5) x10) (* 2 x11) (* 1 x12) (* 5 x13) (* (- 5) x14) (* (- 5) x15) (* (- 4) x16) (* 1 x17) (* (- 4) x18) (* (- 1) x19) (* (- 3) x20) (* 2 x21) (* 2 x22) (* 5 x23) (* 3 x24)) 25))
+(assert (<= (- 44) (+ (* (- 1) x0) (* 1 x1) (* (- 2) x2) (* (- 5) x3) (* 1 x4) (* (- 4) x5) (* 1 x6) (* (- 4) x7) (* (- 2) x8) (* 2 x9) (* 1 x10) (* 2 x11) (* (- 4) x12) (* 2 x13) (* (- 4) x14) (* 1 x15) (* 1 x16) (* (- 4) x17) (* (- 1) x18) (* 2 x19) (* (- 3) x20) (* (- 5) x21) (* 1 x22) (* 5 x23) (* (- 5) x24)) (- 42)))
+(assert (<= (- 49) (+ (* (- 1) x0) (* (- 3) x1) (* (- 3) x2) (* 2 x3) (* 5 x4) (* 2 x5) (* 4 x6) (* (- 5) x7) (* (- 3) x8) (* 3 x9) (* (- 3) x10) (* (- 5) x11) (* 2 x12) (* (- 3) x13) (* 1 x14) (* (- 1) x15) (* 2 x16) (* (- 2) x17) (* 1 x18) (* 5 x19) (* (- 3) x20) (* (- 5) x21) (* 2 x22) (* (- 5) x23) (* 1 x24)) (- 47)))
+(assert (<= (- 23) (+ (* 3 x0) (* 1 x1) (* (- 2) x2) (* (- 3) x3) (* 5 x4) (* 4 x5) (* (- 2) x6) (* 2 x7) (* (- 1) x8) (* (- 1) x9) (* (- 1) x10) (* (- 1) x11) (* 1 x12) (* 2 x13) (* (- 4) x14) (* 2 x15) (* (- 2) x16) (* (- 5) x17) (* 5 x18) (* (- 2) x19) (* (- 2) x20) (* (- 1) x21) (* (- 4) x22) (* 3 x23) (* (- 4) x24)) (- 21)))
+(assert (<= (- 47) (+ (* (- 1) x0) (* (- 4) x1) (* (- 3) x2) (* 5 x3) (* 3 x4) (* (- 4) x5) (* 4 x6) (* (- 2) x7) (* (- 2) x8) (* 1 x9) (* (- 4) x10) (* (- 2) x11) (* (- 5) x12) (* (- 1) x13) (* 1 x14) (* (- 1) x15) (* (- 4) x16) (* 5 x17) (* 2 x18) (* 4 x19) (* 2 x20) (* (- 4) x21) (* (- 4) x22) (* (- 3) x23) (* (- 5) x24)) (- 45)))
+(assert (<= (- 13) (+ (* 4 x0) (* (- 3) x1) (* 5 x2) (* (- 5) x3) (* 3 x4) (* (- 1) x5) (* (- 4) x6) (* (- 4) x7) (* 3 x8) (* 2 x9) (* (- 4) x10) (* (- 5) x11) (* 2 x12) (* (- 2) x13) (* 2 x14) (* (- 5) x15) (* (- 3) x16) (* 3 x17) (* 2 x18) (* 3 x19) (* 1 x20) (* 3 x21) (* (- 4) x22) (* (- 2) x23) (* (- 1) x24)) (- 11)))
+(assert (<= (- 19) (+ (* (- 1) x0) (* (- 5) x1) (* (- 3) x2) (* (- 5) x3) (* 4 x4) (* (- 1) x5) (* (- 2) x6) (* (- 2) x7) (* (- 2) x8) (* (- 4) x9) (* (- 5) x10) (* 3 x11) (* (- 5) x12) (* 5 x13) (* (- 3) x14) (* 2 x15) (* (- 2) x16) (* 5 x17) (* (- 2) x18) (* (- 5) x19) (* 3 x20) (* (- 3) x21) (* 2 x22) (* 5 x23) (* (- 3) x24)) (- 17)))
+(assert (<= (- 56) (+ (* 3 x0) (* (- 1) x1) (* (- 5) x2) (* (- 5) x3) (* 2 x4) (* (- 3) x5) (* 2 x6) (* (- 2) x7) (* (- 3) x8) (* (- 1) x9) (* 5 x10) (* 1 x11) (* (- 4) x12) (* (- 1) x13) (* 1 x14) (* 1 x15) (* (- 1) x16) (* 3 x17) (* (- 5) x18) (* (- 3) x19) (* (- 1) x20) (* (- 2) x21) (* (- 5) x22) (* (- 4) x23) (* 1 x24)) (- 54)))
+(assert (<= 9 (+ (* 2 x0) (* 2 x1) (* (- 5) x2) (* (- 2) x3) (* 5 x4) (* 5 x5) (* (- 4) x6) (* (- 3) x7) (* (- 2) x8) (* 1 x9) (* 4 x10) (* 4 x11) (* (- 2) x12) (* (- 5) x13) (* (- 3) x14) (* 4 x15) (* (- 1) x16) (* (- 1) x17) (* 4 x18) (* (- 3) x19) (* (- 4) x20) (* 5 x21) (* 2 x22) (* 5 x23) (* 3 x24)) 11))
+(assert (<= 33 (+ (* (- 4) x0) (* (- 4) x1) (* 2 x2) (* (- 2) x3) (* 2 x4) (* 1 x5) (* 1 x6) (* 3 x7) (* 1 x8) (* 5 x9) (* 3 x10) (* 2 x11) (* 4 x12) (* 5 x13) (* (- 4) x14) (* 4 x15) (* 2 x16) (* (- 1) x17) (* (- 3) x18) (* 2 x19) (* 3 x20) (* (- 1) x21) (* 3 x22) (* (- 4) x23) (* (- 2) x24)) 35))
+(assert (<= 13 (+ (* 4 x0) (* 4 x1) (* 1 x2) (* (- 5) x3) (* (- 1) x4) (* 4 x5) (* 3 x6) (* 5 x7) (* 5 x8) (* 5 x9) (* (- 4) x10) (* (- 1) x11) (* 4 x12) (* 3 x13) (* (- 5) x14) (* 1 x15) (* (- 2) x16) (* (- 3) x17) (* 3 x18) (* 2 x19) (* (- 1) x20) (* 3 x21) (* (- 3) x22) (* (- 3) x23) (* (- 3) x24)) 15))
+(assert (<= 18 (+ (* (- 1) x0) (* 4 x1) (* (- 1) x2) (* 2 x3) (* 3 x4) (* 1 x5) (* (- 1) x6) (* (- 4) x7) (* (- 4) x8) (* 2 x9) (* 3 x10) (* (- 3) x11) (* (- 5) x12) (* 1 x13) (* 5 x14) (* (- 2) x15) (* (- 5) x16) (* 4 x17) (* 1 x18) (* 5 x19) (* 4 x20) (* 1 x21) (* (- 3) x22) (* (- 1) x23) (* (- 1) x24)) 20))
+(assert (<= 31 (+ (* (- 5) x0) (* (- 5) x1) (* (- 3) x2) (* (- 5) x3) (* 4 x4) (* 1 x5) (* (- 5) x6) (* 1 x7) (* 2 x8) (* 4 x9) (* 5 x10) (* 3 x11) (* 4 x12) (* (- 3) x13) (* (- 2) x14) (* 3 x15) (* 4 x16) (* 5 x17) (* 1 x18) (* 4 x19) (* 2 x20) (* (- 2) x21) (* (- 1) x22) (* (- 1) x23) (* (- 2) x24)) 33))
+(check-sat)
+(push 1)
+(assert (>= x17 3))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (>= x8 3))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (>= x6 1))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (>= x19 2))
+(check-sat)
+(pop 1)
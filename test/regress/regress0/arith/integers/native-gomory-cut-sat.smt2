@@ -0,0 +1,27 @@
+; COMMAND-LINE: --arith-native-cuts --no-dio-solver --incremental --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::arith::nativeGomoryCuts\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT-ERROR: theory::arith::nativeGomoryCuts > 0
+; Cuts with the fractional parts of the row taken with the wrong sign would
+; exclude the only solutions of both problems.
+(set-logic QF_LIRA)
+(declare-fun x () Int)
+(declare-fun t () Int)
+(declare-fun b () Int)
+(declare-fun r () Real)
+(push 1)
+; x = 1/4 + 3/4 t has the only integer solution t = 1 for t in [0, 2].
+(assert (= (* 4 x) (+ 1 (* 3 t))))
+(assert (>= t 0))
+(assert (<= t 2))
+(check-sat)
+(pop 1)
+(push 1)
+; b = 1/4 - r has the only solution b = 0, r = 1/4 for r in [0, 1/2].
+(assert (= (+ b r) 0.25))
+(assert (>= r 0.0))
+(assert (<= r 0.5))
+(check-sat)
+(pop 1)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --arith-native-cuts --incremental --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::arith::nativeGomoryCuts\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT-ERROR: theory::arith::nativeGomoryCuts > 0
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (<= (+ (* 2 x) (* 3 y)) 12))
+(assert (>= (- (* 3 x) y) 1))
+(assert (>= (+ x y) 4))
+(assert (>= x 0))
+(assert (>= y 0))
+(check-sat)
+(push 1)
+(assert (>= (+ x (* 4 y)) 12))
+(check-sat)
+(pop 1)
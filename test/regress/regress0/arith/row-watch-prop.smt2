@@ -0,0 +1,34 @@
+; COMMAND-LINE: --arith-prop=bi --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::arith::bound::impliedBySingletonRows\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: unsat
+; EXPECT-ERROR: theory::arith::bound::impliedBySingletonRows > 0
+(set-logic QF_LRA)
+(declare-fun x0 () Real)
+(declare-fun x1 () Real)
+(declare-fun x2 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(declare-fun x6 () Real)
+(declare-fun x7 () Real)
+(declare-fun x8 () Real)
+(declare-fun x9 () Real)
+(declare-fun x10 () Real)
+(declare-fun x11 () Real)
+(assert (and (>= x0 0) (<= x0 1)))
+(assert (and (>= x1 0) (<= x1 2)))
+(assert (and (>= x2 0) (<= x2 3)))
+(assert (and (>= x3 0) (<= x3 4)))
+(assert (and (>= x4 0) (<= x4 5)))
+(assert (and (>= x5 0) (<= x5 6)))
+(assert (and (>= x6 0) (<= x6 7)))
+(assert (and (>= x7 0) (<= x7 8)))
+(assert (and (>= x8 0) (<= x8 9)))
+(assert (and (>= x9 0) (<= x9 10)))
+(assert (and (>= x10 0) (<= x10 11)))
+(assert (and (>= x11 0) (<= x11 12)))
+(declare-fun s () Real)
+(assert (= s (+ (* 1 x0) (* 2 x1) (* 3 x2) (* 1 x3) (* 2 x4) (* 3 x5) (* 1 x6) (* 2 x7) (* 3 x8) (* 1 x9) (* 2 x10) (* 3 x11))))
+(assert (or (>= s 200) (>= x0 2)))
+(check-sat)
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-aig-bitblaster --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::BBAig::numAigNodes\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::BBAig::numAigNodes > 0
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (bvxor x y) (bvor x z)))
+(assert (bvult x y))
+(check-sat)
+(push 1)
+(assert (bvult (bvor x y) x))
+(check-sat)
+(pop 1)
+(assert (= (bvudiv x #x03) #x05))
+(check-sat)
@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-aig-bitblaster --bv-bb-threads=4 --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::BBAig::numParallelAtoms\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::BBAig::numParallelAtoms > 0
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(declare-fun c () (_ BitVec 8))
+(declare-fun d () (_ BitVec 8))
+(declare-fun e () (_ BitVec 8))
+(declare-fun f () (_ BitVec 8))
+(declare-fun g () (_ BitVec 8))
+(declare-fun h () (_ BitVec 8))
+; Four atoms with disjoint cones, one per thread.
+(assert (= (bvadd a #x11) (bvshl b #x01)))
+(assert (bvult (bvudiv c #x03) d))
+(assert (= (bvxor e f) #x5a))
+(assert (bvslt (bvsub g h) #x00))
+(check-sat)
+(push 1)
+(assert (= (bvand a #x01) #x00))
+(check-sat)
+(pop 1)
+(assert (= (concat e g) #x1234))
+(check-sat)
@@ -0,0 +1,23 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-gc-checks=1 --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::BVSolverBitblast::numRebuilds\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::BVSolverBitblast::numRebuilds > 0
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (bvult x y))
+(push 1)
+(assert (= (bvmul x #x03) #x15))
+(assert (bvugt y #x10))
+(assert (= (bvand y #x0f) #x01))
+(assert (bvult (bvadd x y) #x40))
+(check-sat)
+(pop 1)
+(check-sat)
+; The four facts of the popped scope were unused in the last check, and are
+; dropped by rebuilding the SAT solver.
+(assert (= (bvudiv y x) #x05))
+(check-sat)
@@ -0,0 +1,32 @@
+; COMMAND-LINE: --incremental --bv-known-bits --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -E -e "s/^(preprocessing::passes::BvKnownBits::num(Constants|DecidedAtoms|FixedBits|Seeds)), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT-ERROR: preprocessing::passes::BvKnownBits::numConstants > 0
+; EXPECT-ERROR: preprocessing::passes::BvKnownBits::numDecidedAtoms > 0
+; EXPECT-ERROR: preprocessing::passes::BvKnownBits::numFixedBits > 0
+; EXPECT-ERROR: preprocessing::passes::BvKnownBits::numSeeds > 0
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun p () Bool)
+(push 1)
+(assert (= ((_ extract 7 4) x) #x3))
+(assert (bvult y #x10))
+(assert (= (bvand x y) #x05))
+(assert (or (bvugt x #x20) p))
+(assert (distinct (bvadd x y) #x00))
+(assert (distinct (bvadd ((_ extract 7 4) x) ((_ extract 3 0) y)) #x0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= ((_ extract 7 4) x) #x3))
+(assert (bvult y #x10))
+(assert (or (= (bvlshr y #x04) #x01) (bvult x #x30) (bvslt x #x00)))
+(check-sat)
+(pop 1)
+(assert (= ((_ extract 7 4) x) #x3))
+(assert (= (bvadd x #x01) #x00))
+(check-sat)
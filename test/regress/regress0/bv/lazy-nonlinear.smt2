@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-lazy-nonlinear --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::BVSolverBitblast::numRefinements\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::BVSolverBitblast::numRefinements > 0
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+; Only x = 17 satisfies both, which the axioms of the abstractions alone do
+; not imply.
+(assert (= (bvurem x #x0007) #x0003))
+(assert (= (bvudiv x #x0007) #x0002))
+(check-sat)
+(push 1)
+(assert (bvult x #x0010))
+(check-sat)
+(pop 1)
+(assert (= (bvmul x y) (bvadd y #x0010)))
+(check-sat)
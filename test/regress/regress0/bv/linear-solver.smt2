@@ -0,0 +1,35 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-linear-solver --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::BVLinearSolver::numConflicts\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::BVLinearSolver::numConflicts > 0
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun z () (_ BitVec 32))
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(push 1)
+(assert (= (bvadd (bvmul #x00000002 x) (bvmul #x00000004 y)) #x00000001))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvadd x y) #x0000000a))
+(assert (= (bvadd x (bvmul #x00000002 y)) #x0000000d))
+(check-sat)
+(assert (distinct x #x00000007))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvadd (bvmul #x00000003 x) (bvmul #x00000005 y) z) #x00000000))
+(assert (= x y))
+(assert (distinct (bvmul #x00000008 z) (bvneg (bvmul #x00000040 x))))
+(check-sat)
+(pop 1)
+(assert (= (bvadd (bvmul a b) a) #x05))
+(assert (= (bvsub a (bvshl b #x01)) #x01))
+(check-sat)
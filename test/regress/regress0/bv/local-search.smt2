@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-local-search --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::BVLocalSearch::numSat\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::BVLocalSearch::numSat > 0
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(assert (= (bvadd x #x0005) y))
+(assert (bvult y #x0100))
+(assert (= (bvand x #x00f0) #x0030))
+(check-sat)
+(push 1)
+(assert (bvult y #x0030))
+(check-sat)
+(pop 1)
+(assert (bvugt (bvmul x #x0003) #x00a0))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --bv-solver=bitblast --bv-mult=wallace --bv-mult-csd --bv-div=iterative
+; COMMAND-LINE: --bv-solver=bitblast --bv-mult=dadda --bv-div=iterative
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 12))
+(declare-fun y () (_ BitVec 12))
+(declare-fun z () (_ BitVec 12))
+(assert (= (bvmul x #x0e7) (bvmul #x0e7 x)))
+(assert (= z (bvudiv (bvmul x y) y)))
+(assert (bvult x #x010))
+(assert (bvult y #x010))
+(assert (not (= y #x000)))
+(assert (not (and (= z x) (= (bvurem (bvmul x y) y) #x000))))
+(check-sat)
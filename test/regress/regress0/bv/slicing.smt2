@@ -0,0 +1,33 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-slicing --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e "s/^\(theory::bv::Slicer::numUnsat\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: theory::bv::Slicer::numUnsat > 0
+(set-logic QF_BV)
+(declare-fun m () (_ BitVec 32))
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 8))
+(assert (= m (concat x y)))
+(assert (= ((_ extract 23 16) m) z))
+(assert (= ((_ extract 7 0) y) ((_ extract 15 8) x)))
+(assert (distinct ((_ extract 15 8) x) z))
+(check-sat)
+(push 1)
+(assert (= ((_ extract 31 24) m) #xab))
+(assert (= ((_ extract 15 8) y) #xcd))
+(assert (= (concat z #x01) (concat ((_ extract 15 8) y) ((_ extract 7 0) y))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (concat ((_ extract 15 8) x) z) (concat ((_ extract 7 0) y) ((_ extract 23 16) m))))
+(assert (= x (concat ((_ extract 7 0) y) ((_ extract 7 0) x))))
+(assert (= ((_ extract 15 8) x) z))
+(check-sat)
+(pop 1)
+(assert (= ((_ extract 3 0) z) #x5))
+(assert (distinct m #x00000000))
+(check-sat)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --lemma-batch --check-models
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun n () Int)
+(assert (= (str.++ x "ab") (str.++ "ba" y)))
+(assert (< (str.len x) 2))
+(assert (= n (+ (str.len x) (str.len y))))
+(assert (> n 1))
+(check-sat)
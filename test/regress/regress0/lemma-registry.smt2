@@ -0,0 +1,16 @@
+; COMMAND-LINE: --lemma-registry --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (= (str.++ x "ab") (str.++ "ba" y)))
+(assert (< (str.len x) 2))
+(check-sat)
+(push 1)
+(assert (= (str.len x) 0))
+(check-sat)
+(pop 1)
+(assert (= y "b"))
+(check-sat)
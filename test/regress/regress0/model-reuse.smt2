@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --model-reuse --check-models
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun f (U) Int)
+(declare-fun x () Int)
+(assert (not (= a b)))
+(assert (> (f a) x))
+(check-sat)
+(push 1)
+(assert (= b c))
+(check-sat)
+(pop 1)
+(assert (not (= a c)))
+(check-sat)
+(push 1)
+(assert (= (f a) (f b)))
+(assert (= (f b) (f c)))
+(assert (< (f c) x))
+(check-sat)
+(pop 1)
@@ -0,0 +1,38 @@
+; COMMAND-LINE: --incremental --no-nl-ext --nl-cad --nl-cad-cache --stats
+; REQUIRES: poly
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -E -e "s/^(nl::cad::cache::(cover|discriminant|root)Hits), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT-ERROR: nl::cad::cache::coverHits > 0
+; EXPECT-ERROR: nl::cad::cache::discriminantHits > 0
+; EXPECT-ERROR: nl::cad::cache::rootHits > 0
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (> (* x x) 1.0))
+(check-sat)
+(push 1)
+(assert (< (+ (* x x) (* y y)) 1.0))
+(check-sat)
+(pop 1)
+(check-sat)
+(push 1)
+(assert (= (* x y) 2.0))
+(assert (< x 0.0))
+(assert (> y 0.0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (< (+ (* x x) (* y y)) 1.0))
+(check-sat)
+(pop 1)
+; the same constraints again reuse the covering of the last check
+(push 1)
+(assert (< (+ (* x x) (* y y)) 1.0))
+(check-sat)
+(pop 1)
@@ -0,0 +1,15 @@
+; REQUIRES: poly
+; REQUIRES: statistics
+; COMMAND-LINE: --nl-icp --nl-icp-batch --stats
+; ERROR-SCRUBBER: sed -n -e "s/^\(nl::icp::skippedCandidates\), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: unsat
+; EXPECT-ERROR: nl::icp::skippedCandidates > 0
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (>= x 2.0))
+(assert (= y (* x x)))
+(assert (= z (+ y (* 3.0 x))))
+(assert (< z 9.5))
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --nl-adaptive-strategy
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(push 1)
+(assert (> (* x y) 0.0))
+(assert (> x 0.0))
+(assert (< y 0.0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (> x 1.0))
+(assert (> (* x y z) 0.0))
+(assert (< (* y z) 0.0))
+(check-sat)
+(pop 1)
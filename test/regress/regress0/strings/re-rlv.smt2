@@ -0,0 +1,10 @@
+; COMMAND-LINE: --strings-exp --re-rlv --check-models
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (or (str.in_re x (re.+ (str.to_re "a"))) (str.in_re y (re.+ (str.to_re "b")))))
+(assert (str.in_re x (re.* (str.to_re "c"))))
+(assert (= (str.len x) 1))
+(assert (= (str.len y) 2))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --theory-profile --theory-profile-sample=4 --stats
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -E -e "s/^(theory::(arith|uf)::profile::preRegister::calls), [1-9][0-9]*$/\1 > 0/p"
+; EXPECT: unsat
+; EXPECT-ERROR: theory::arith::profile::preRegister::calls > 0
+; EXPECT-ERROR: theory::uf::profile::preRegister::calls > 0
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (<= x y))
+(assert (<= y x))
+(assert (not (= (f x) (f y))))
+(check-sat)
@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file cadical_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::prop::CadicalSolver.
+ **
+ ** Black box testing of CVC4::prop::CadicalSolver.
+ **/
+
+#include <memory>
+#include <vector>
+
+#include "prop/sat_solver.h"
+#include "prop/sat_solver_factory.h"
+#include "test.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+
+using namespace prop;
+
+namespace test {
+
+class TestPropBlackCadical : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    d_registry.reset(new StatisticsRegistry());
+    d_solver.reset(SatSolverFactory::createCadical(d_registry.get(), "test"));
+    d_a = SatLiteral(d_solver->newVar(false, false, true));
+    d_b = SatLiteral(d_solver->newVar(false, false, true));
+  }
+
+  void TearDown() override
+  {
+    d_solver.reset(nullptr);
+    d_registry.reset(nullptr);
+  }
+
+  void addClause(std::vector<SatLiteral> lits, bool removable = false)
+  {
+    SatClause clause(lits.begin(), lits.end());
+    d_solver->addClause(clause, removable);
+  }
+
+  std::unique_ptr<StatisticsRegistry> d_registry;
+  std::unique_ptr<SatSolver> d_solver;
+  SatLiteral d_a;
+  SatLiteral d_b;
+};
+
+TEST_F(TestPropBlackCadical, push_pop)
+{
+  addClause({d_a, d_b});
+  ASSERT_EQ(d_solver->getAssertionLevel(), 0u);
+
+  d_solver->push();
+  addClause({~d_a});
+  ASSERT_EQ(d_solver->getAssertionLevel(), 1u);
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_TRUE);
+  ASSERT_EQ(d_solver->modelValue(d_b), SAT_VALUE_TRUE);
+
+  d_solver->push();
+  addClause({~d_b});
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_FALSE);
+  d_solver->pop();
+
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_TRUE);
+  d_solver->pop();
+  ASSERT_EQ(d_solver->getAssertionLevel(), 0u);
+
+  addClause({~d_b});
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_TRUE);
+  ASSERT_EQ(d_solver->modelValue(d_a), SAT_VALUE_TRUE);
+}
+
+TEST_F(TestPropBlackCadical, removable_survives_pop)
+{
+  d_solver->push();
+  addClause({~d_a}, true);
+  addClause({~d_b});
+  d_solver->pop();
+
+  ASSERT_EQ(d_solver->solve({d_b}), SAT_VALUE_TRUE);
+  ASSERT_EQ(d_solver->solve({d_a}), SAT_VALUE_FALSE);
+}
+
+TEST_F(TestPropBlackCadical, unsat_assumptions)
+{
+  addClause({~d_a, ~d_b});
+
+  d_solver->push();
+  SatLiteral c(d_solver->newVar(false, false, true));
+  addClause({~c});
+  ASSERT_EQ(d_solver->solve({d_a, c}), SAT_VALUE_FALSE);
+
+  std::vector<SatLiteral> unsat;
+  d_solver->getUnsatAssumptions(unsat);
+  ASSERT_EQ(unsat, std::vector<SatLiteral>{c});
+
+  ASSERT_EQ(d_solver->solve({d_a, d_b}), SAT_VALUE_FALSE);
+  unsat.clear();
+  d_solver->getUnsatAssumptions(unsat);
+  ASSERT_FALSE(unsat.empty());
+  for (const SatLiteral& lit : unsat)
+  {
+    ASSERT_TRUE(lit == d_a || lit == d_b);
+  }
+  d_solver->pop();
+
+  ASSERT_EQ(d_solver->solve({d_a}), SAT_VALUE_TRUE);
+}
+
+}  // namespace test
+}  // namespace CVC4
@@ -0,0 +1,198 @@
+/*********************                                                        */
+/*! \file theory_arith_tableau_white.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Whitebox tests for the compaction of the arithmetic tableau.
+ **/
+
+#include <utility>
+#include <vector>
+
+#include "test.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+
+using namespace theory::arith;
+
+namespace test {
+
+class TestTheoryWhiteArithTableau : public TestInternal
+{
+ protected:
+  typedef std::vector<std::vector<std::pair<ArithVar, Rational>>> Rows;
+  typedef std::vector<std::vector<std::pair<RowIndex, Rational>>> Columns;
+
+  /**
+   * Adds d_numRows rows over the d_numCols variables that follow the basic
+   * ones, with all coefficients non-zero.
+   */
+  void addRows(Tableau& t)
+  {
+    t.increaseSizeTo(d_numRows + d_numCols);
+    for (ArithVar b = 0; b < d_numRows; ++b)
+    {
+      std::vector<Rational> coeffs;
+      std::vector<ArithVar> vars;
+      for (uint32_t j = 0; j < d_numCols; ++j)
+      {
+        int c = static_cast<int>((b * 7 + j * 3) % 9) - 4;
+        coeffs.push_back(Rational(c == 0 ? 5 : c));
+        vars.push_back(d_numRows + j);
+      }
+      t.addRow(b, coeffs, vars);
+    }
+  }
+
+  /** Pivots `n` times, each time on the first non-basic variable of a row. */
+  void pivot(Tableau& t, uint32_t n)
+  {
+    NoEffectCCCB cb;
+    for (uint32_t k = 0; k < n; ++k)
+    {
+      ArithVar basic = t.rowIndexToBasic(k % t.getNumRows());
+      ArithVar nonbasic = ARITHVAR_SENTINEL;
+      for (Tableau::RowIterator i = t.basicRowIterator(basic); !i.atEnd(); ++i)
+      {
+        if ((*i).getColVar() != basic)
+        {
+          nonbasic = (*i).getColVar();
+          break;
+        }
+      }
+      ASSERT_NE(nonbasic, ARITHVAR_SENTINEL);
+      t.pivot(basic, nonbasic, cb);
+    }
+  }
+
+  Rows getRows(const Tableau& t)
+  {
+    Rows rows(t.getNumRows());
+    for (RowIndex r = 0; r < t.getNumRows(); ++r)
+    {
+      for (Tableau::RowIterator i = t.ridRowIterator(r); !i.atEnd(); ++i)
+      {
+        rows[r].emplace_back((*i).getColVar(), (*i).getCoefficient());
+      }
+    }
+    return rows;
+  }
+
+  Columns getColumns(const Tableau& t)
+  {
+    Columns cols(t.getNumColumns());
+    for (ArithVar v = 0; v < t.getNumColumns(); ++v)
+    {
+      for (Tableau::ColIterator i = t.colIterator(v); !i.atEnd(); ++i)
+      {
+        cols[v].emplace_back((*i).getRowIndex(), (*i).getCoefficient());
+      }
+    }
+    return cols;
+  }
+
+  /**
+   * Checks that the row and column lists are doubly linked, that their
+   * entries belong to them, and that their lengths are right.
+   */
+  void checkLinks(const Tableau& t)
+  {
+    uint32_t rowEntries = 0;
+    for (RowIndex r = 0; r < t.getNumRows(); ++r)
+    {
+      uint32_t length = 0;
+      EntryID prev = ENTRYID_SENTINEL;
+      for (Tableau::RowIterator i = t.ridRowIterator(r); !i.atEnd(); ++i)
+      {
+        const Tableau::Entry& e = *i;
+        ASSERT_FALSE(e.blank());
+        ASSERT_EQ(e.getRowIndex(), r);
+        ASSERT_EQ(e.getPrevRowEntryID(), prev);
+        prev = i.getID();
+        ++length;
+      }
+      ASSERT_EQ(length, t.getRowLength(r));
+      rowEntries += length;
+    }
+    uint32_t colEntries = 0;
+    for (ArithVar v = 0; v < t.getNumColumns(); ++v)
+    {
+      uint32_t length = 0;
+      EntryID prev = ENTRYID_SENTINEL;
+      for (Tableau::ColIterator i = t.colIterator(v); !i.atEnd(); ++i)
+      {
+        const Tableau::Entry& e = *i;
+        ASSERT_FALSE(e.blank());
+        ASSERT_EQ(e.getColVar(), v);
+        ASSERT_EQ(e.getPrevColEntryID(), prev);
+        prev = i.getID();
+        ++length;
+      }
+      ASSERT_EQ(length, t.getColLength(v));
+      colEntries += length;
+    }
+    ASSERT_EQ(rowEntries, t.d_entriesInUse);
+    ASSERT_EQ(colEntries, t.d_entriesInUse);
+  }
+
+  uint32_t d_numRows = 12;
+  uint32_t d_numCols = 8;
+};
+
+TEST_F(TestTheoryWhiteArithTableau, compact)
+{
+  Tableau t;
+  addRows(t);
+  pivot(t, 30);
+  checkLinks(t);
+  Rows rows = getRows(t);
+  Columns cols = getColumns(t);
+
+  t.compact();
+
+  checkLinks(t);
+  ASSERT_EQ(t.d_entriesAddedSinceCompact, 0u);
+  ASSERT_EQ(getRows(t), rows);
+  ASSERT_EQ(getColumns(t), cols);
+
+  // The entries of each row are contiguous, rows in order of their index.
+  EntryID next = 0;
+  for (RowIndex r = 0; r < t.getNumRows(); ++r)
+  {
+    for (Tableau::RowIterator i = t.ridRowIterator(r); !i.atEnd(); ++i)
+    {
+      ASSERT_EQ(i.getID(), next);
+      ++next;
+    }
+  }
+}
+
+TEST_F(TestTheoryWhiteArithTableau, pivot_after_compact)
+{
+  Tableau t, u;
+  addRows(t);
+  addRows(u);
+  pivot(t, 10);
+  pivot(u, 10);
+
+  t.compact();
+  pivot(t, 20);
+  pivot(u, 20);
+
+  checkLinks(t);
+  ASSERT_EQ(getRows(t), getRows(u));
+  ASSERT_EQ(getColumns(t), getColumns(u));
+  for (ArithVar v = 0; v < d_numRows + d_numCols; ++v)
+  {
+    ASSERT_EQ(t.isBasic(v), u.isBasic(v));
+  }
+}
+}  // namespace test
+}  // namespace CVC4
@@ -14,6 +14,7 @@
  ** Black box testing of CVC4::Rational.
  **/
 
+#include <limits>
 #include <sstream>
 
 #include "test.h"
@@ -43,5 +44,47 @@ TEST_F(TestUtilBlackRational, fromDecimal)
   ASSERT_THROW(Rational::fromDecimal("1.2/3");, std::invalid_argument);
   ASSERT_THROW(Rational::fromDecimal("Hello, world!");, std::invalid_argument);
 }
+
+TEST_F(TestUtilBlackRational, overflow)
+{
+  Rational max(std::numeric_limits<long>::max(), 1l);
+  Rational min(std::numeric_limits<long>::min(), 1l);
+  Rational one(1, 1);
+  Integer intMax(std::numeric_limits<long>::max());
+  Integer intMin(std::numeric_limits<long>::min());
+
+  Rational maxPlusOne = max + one;
+  ASSERT_EQ(maxPlusOne.getNumerator(), intMax + Integer(1));
+  ASSERT_EQ(maxPlusOne - one, max);
+  ASSERT_EQ((maxPlusOne - one).hash(), max.hash());
+  ASSERT_GT(maxPlusOne, max);
+
+  ASSERT_EQ(min - one, Rational(intMin - Integer(1)));
+  ASSERT_EQ((-min).getNumerator(), -intMin);
+  ASSERT_EQ(-(-min), min);
+  ASSERT_EQ(min.abs().getNumerator(), -intMin);
+
+  Rational sq = max * max;
+  ASSERT_EQ(sq.getNumerator(), intMax * intMax);
+  ASSERT_EQ(sq / max, max);
+  ASSERT_EQ(max * min, Rational(intMax * intMin));
+
+  Rational small(1l, std::numeric_limits<long>::max());
+  Rational smaller = small * small;
+  ASSERT_EQ(smaller.getDenominator(), intMax * intMax);
+  ASSERT_EQ(smaller * max, small);
+  ASSERT_LT(smaller, small);
+  ASSERT_EQ(Rational(1l, std::numeric_limits<long>::min()).getDenominator(),
+            -intMin);
+
+  Rational third(1, 3);
+  Rational sum = max / Rational(3, 1) + third;
+  ASSERT_EQ(sum.getNumerator(), (intMax + Integer(1)));
+  ASSERT_EQ(sum.getDenominator(), Integer(3));
+  ASSERT_EQ(sum.floor(), (intMax + Integer(1)).floorDivideQuotient(3));
+  ASSERT_EQ(sum.ceiling(), sum.floor() + Integer(1));
+  ASSERT_EQ(Rational(-7, 2).floor(), Integer(-4));
+  ASSERT_EQ(Rational(-7, 2).ceiling(), Integer(-3));
+}
 }  // namespace test
 }  // namespace CVC4